@@ -0,0 +1,1760 @@
+/**
+ * Solaire Benchmarks
+ *
+ * Console app timing the DSP core outside a plugin host: the full SolaireEngine,
+ * the analysis stages on their own, and the partial matchers.
+ *
+ * Run: solaire_bench [--quick] [--only=engine|frames|profile|memory|multires|governor|capacity|
+ *                                   synthesis|fft|sleep|float|rtsafety|matching]
+ *                    [--input=<audio file>] [--block=<samples>]
+ *                    [--golden=<file>] [--write-golden] [--budget=<fraction>]
+ *
+ * - engine:   ns per sample and per-block mean / p99 / p999 / max for window order 7-19,
+ *             VOICES, every waveform and every analysis mode
+ * - frames:   per-call FFT, extractDominantPeaks and PartialTrackingEngine::processFrame
+ *             cost on synthetic spectra (and on recorded spectra with --input), plus the
+ *             cost of a whole SolaireEngine::processFrame measured inside the engine
+ * - profile:  SolaireEngine's own per-stage counters and xruns (builds with
+ *             SOLAIRE_ENABLE_PROFILING=1 only)
+ * - memory:   bytes allocated per engine instance and touched per frame at each order
+ * - multires: multi-resolution (octave band) analysis against single windows - pitch
+ *             error on close bass partials and FFT work for the same bass resolution
+ * - governor: quality tiers chosen by the opt-in governor under a budget the engine
+ *             cannot meet at full quality, then under a generous one (recovery)
+ * - capacity: the BasicOscillatorBank capacities the engine plays (8, 16, 33) and the
+ *             largest build (256), per render kernel with all voices sounding, a
+ *             256-voice bank with 8-256 voices sounding, and the whole engine at
+ *             VOICES 8 / 16 / 33
+ * - synthesis: the inverse-FFT overlap-add backend against oscillator banks at
+ *             33-512 partials (sine and saw)
+ * - fft:      frame copy out of the input ring (two-part copy + window against the
+ *             fused copy from the mirrored ring), and JuceFFTBackend against the
+ *             build's FFTBackend (CMake SOLAIRE_FFT_BACKEND) at every order
+ * - sleep:    CPU of a sleeping engine against one kept awake, through signal, the
+ *             voices' release, silence and the signal again (and the output difference)
+ * - float:    the FLOAT stage (FloatReverb: one stereo reverb per block, skipped at 0)
+ *             against a mono reverb per channel re-parameterised on every call
+ * - rtsafety: the engine and FLOAT stage swept through TIME, VOICES, WAVEFORM, FREEZE,
+ *             the modifiers, snapshots and sleep in every analysis mode, and a
+ *             group of engines on the ChannelWorkerPool, with the audio thread
+ *             guarded (AudioThreadGuard.h): any allocation, free or mutex call
+ *             after prepareToPlay() in any configuration, a block slower than
+ *             --budget of its duration (only checked when given) or output that
+ *             no longer matches --golden (a missing file fails too; --write-golden
+ *             regenerates it) fails the run with exit code 1 (CTest runs it as
+ *             solaire_rtsafety, against Benchmarks/rtsafety_golden.txt once that
+ *             file exists)
+ * - matching: greedy vs sorted-merge partial matching
+ *
+ * Worst-case figures matter more than means here: a block that misses its deadline
+ * is an audible dropout however cheap the average block is.
+ *
+ * SOURCES:
+ * - JUCE CMake ConsoleApp example: juce_add_console_app target layout
+ * - juce::Time high-resolution ticks (standard JUCE timing pattern)
+ * - juce::ArgumentList (JUCE ConsoleApplication helpers)
+ */
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include "SolaireEngine.h"
+#include "FloatReverb.h"
+#include "ChannelWorkerPool.h"
+#include "AudioThreadGuard.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+    //==============================================================================
+    // Synthetic frame data: tracks log-spaced over the audio band, peaks drifted
+    // slightly from their tracks plus some newborn peaks, ordered by magnitude
+    // (as extractDominantPeaks returns them). binIndex holds the index of the track
+    // a peak truly continues, or -1 for newborn peaks.
+    struct MatchingScenario
+    {
+        std::vector<PartialTrack> tracks;
+        std::vector<SpectralPeak> peaks;
+    };
+
+    MatchingScenario makeMatchingScenario(int numPartials, juce::Random& random)
+    {
+        MatchingScenario scenario;
+        scenario.tracks.resize(static_cast<size_t>(numPartials));
+
+        for (int i = 0; i < numPartials; ++i)
+        {
+            const float position = (static_cast<float>(i) + random.nextFloat()) / static_cast<float>(numPartials);
+            const float frequency = 40.0f * std::pow(400.0f, position);  // 40 Hz - 16 kHz
+            scenario.tracks[static_cast<size_t>(i)] =
+                PartialTrack(i, SpectralPeak(frequency, random.nextFloat(), 0.0f, 0));
+        }
+
+        for (const auto& track : scenario.tracks)
+        {
+            // 90% of tracks continue with a peak within +-2%, the rest die
+            if (random.nextFloat() < 0.9f)
+            {
+                const float drift = 1.0f + (random.nextFloat() - 0.5f) * 0.04f;
+                scenario.peaks.emplace_back(track.frequency * drift, random.nextFloat(), 0.0f, track.trackID);
+            }
+        }
+
+        while (static_cast<int>(scenario.peaks.size()) < numPartials)
+            scenario.peaks.emplace_back(40.0f * std::pow(400.0f, random.nextFloat()), random.nextFloat(), 0.0f, -1);
+
+        std::sort(scenario.peaks.begin(), scenario.peaks.end(),
+                  [](const SpectralPeak& a, const SpectralPeak& b) { return a.magnitude > b.magnitude; });
+
+        return scenario;
+    }
+
+    // Tracks matched to the peak that truly continues them
+    int countCorrectMatches(const MatchingScenario& scenario, const std::vector<int>& peakForTrack)
+    {
+        int correct = 0;
+
+        for (size_t t = 0; t < peakForTrack.size(); ++t)
+        {
+            const int peak = peakForTrack[t];
+
+            if (peak >= 0 && scenario.peaks[static_cast<size_t>(peak)].binIndex == static_cast<int>(t))
+                ++correct;
+        }
+
+        return correct;
+    }
+
+    //==============================================================================
+    struct BenchOptions
+    {
+        bool quick = false;          // Shorter signals, for a fast sanity pass
+        juce::String only;           // Empty = every section
+        juce::String inputPath;      // Recorded material for the frames section
+        int blockSize = 256;         // Host block size for the engine section
+        juce::String goldenPath;     // rtsafety: reference output
+        bool writeGolden = false;    // rtsafety: regenerate goldenPath instead of comparing
+        double budget = 0.0;         // rtsafety: worst block as a fraction of its duration (0 = not checked)
+
+        bool wants(const char* section) const { return only.isEmpty() || only == section; }
+    };
+
+    //==============================================================================
+    // Mean microseconds per call of fn over the given number of iterations
+    template <typename Function>
+    double timeMicroseconds(int iterations, Function&& fn)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        for (int i = 0; i < iterations; ++i)
+            fn();
+
+        const double seconds = juce::Time::highResolutionTicksToSeconds(
+            juce::Time::getHighResolutionTicks() - start);
+        return seconds * 1.0e6 / static_cast<double>(iterations);
+    }
+
+    // Microseconds taken by a single call of fn (for per-call distributions)
+    template <typename Function>
+    double timeCallMicroseconds(Function&& fn)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+        fn();
+        return juce::Time::highResolutionTicksToSeconds(
+                   juce::Time::getHighResolutionTicks() - start) * 1.0e6;
+    }
+
+    struct TimingSummary
+    {
+        double mean = 0.0, p50 = 0.0, p99 = 0.0, p999 = 0.0, max = 0.0;
+    };
+
+    // Nearest-rank percentiles of a set of per-call times
+    TimingSummary summarise(std::vector<double> times)
+    {
+        TimingSummary summary;
+
+        if (times.empty())
+            return summary;
+
+        std::sort(times.begin(), times.end());
+
+        auto percentile = [&times](double fraction) {
+            const auto rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(times.size())));
+            return times[juce::jlimit<size_t>(0, times.size() - 1, rank == 0 ? 0 : rank - 1)];
+        };
+
+        double sum = 0.0;
+        for (double t : times)
+            sum += t;
+
+        summary.mean = sum / static_cast<double>(times.size());
+        summary.p50 = percentile(0.5);
+        summary.p99 = percentile(0.99);
+        summary.p999 = percentile(0.999);
+        summary.max = times.back();
+        return summary;
+    }
+
+    //==============================================================================
+    // Test material: mono samples plus the rate they were recorded/generated at
+    struct TestSignal
+    {
+        juce::String name;
+        std::vector<float> samples;
+        double sampleRate = 48000.0;
+    };
+
+    // Three slowly gliding harmonic tones over a low noise floor: dense, moving
+    // partials (the tracker's busy case) that are identical on every run
+    TestSignal makeSyntheticSignal(double seconds, double sampleRate)
+    {
+        TestSignal signal;
+        signal.name = "synthetic";
+        signal.sampleRate = sampleRate;
+        signal.samples.resize(static_cast<size_t>(seconds * sampleRate));
+
+        constexpr int numHarmonics = 12;
+        const std::array<double, 3> fundamentals { 110.0, 164.8, 277.2 };
+        std::array<double, 3> phases {};
+        juce::Random random(0x5a1a17e);
+
+        for (size_t n = 0; n < signal.samples.size(); ++n)
+        {
+            const double time = static_cast<double>(n) / sampleRate;
+            float sample = 0.0f;
+
+            for (size_t v = 0; v < fundamentals.size(); ++v)
+            {
+                // +-1% vibrato at a different rate per voice
+                const double frequency = fundamentals[v] * (1.0 + 0.01 * std::sin(2.0 * juce::MathConstants<double>::pi
+                                                                                  * (0.3 + 0.2 * static_cast<double>(v)) * time));
+                phases[v] += 2.0 * juce::MathConstants<double>::pi * frequency / sampleRate;
+
+                for (int h = 1; h <= numHarmonics; ++h)
+                    sample += static_cast<float>(std::sin(phases[v] * h) / h);
+            }
+
+            signal.samples[n] = 0.15f * sample + 0.01f * (random.nextFloat() * 2.0f - 1.0f);
+        }
+
+        return signal;
+    }
+
+    // First channels mixed to mono, at most maxSeconds long
+    bool loadRecordedSignal(const juce::String& path, double maxSeconds, TestSignal& signal)
+    {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(
+            formatManager.createReaderFor(juce::File::getCurrentWorkingDirectory().getChildFile(path)));
+
+        if (reader == nullptr || reader->numChannels == 0)
+            return false;
+
+        const auto numSamples = static_cast<int>(std::min<juce::int64>(
+            reader->lengthInSamples, static_cast<juce::int64>(maxSeconds * reader->sampleRate)));
+        const auto numChannels = static_cast<int>(reader->numChannels);
+
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        reader->read(&buffer, 0, numSamples, 0, true, true);
+
+        signal.name = "recorded";
+        signal.sampleRate = reader->sampleRate;
+        signal.samples.assign(static_cast<size_t>(numSamples), 0.0f);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                signal.samples[static_cast<size_t>(i)] += buffer.getSample(channel, i) / static_cast<float>(numChannels);
+
+        return numSamples > 0;
+    }
+
+    //==============================================================================
+    struct EngineSettings
+    {
+        int fftOrder = 10;
+        int voices = 33;       // VOICES: 1-33 active oscillators
+        int waveform = 0;      // 0 = sine, 1 = triangle, 2 = saw, 3 = square
+        SolaireEngine::AnalysisMode mode = SolaireEngine::AnalysisMode::synchronous;
+        int bands = 1;         // Multi-resolution analysis bands (1 = single window)
+    };
+
+    const char* getWaveformName(int waveform)
+    {
+        static const char* const names[] { "sine", "triangle", "saw", "square" };
+        return names[juce::jlimit(0, 3, waveform)];
+    }
+
+    const char* getModeName(SolaireEngine::AnalysisMode mode)
+    {
+        switch (mode)
+        {
+            case SolaireEngine::AnalysisMode::asynchronous: return "async";
+            case SolaireEngine::AnalysisMode::amortised:    return "amortised";
+            case SolaireEngine::AnalysisMode::synchronous:
+            default:                                        return "sync";
+        }
+    }
+
+    // Engine prepared as the processor would, with settings mapped onto the 0-1 parameters
+    std::unique_ptr<SolaireEngine> createEngine(const EngineSettings& settings, double sampleRate, int blockSize)
+    {
+        auto engine = std::make_unique<SolaireEngine>();
+
+        engine->setAnalysisMode(settings.mode);
+        engine->setFFTOrder(settings.fftOrder);
+        engine->setAnalysisBands(settings.bands);
+        engine->setVoice(static_cast<float>(settings.voices - 1) / 32.0f);
+        engine->setWaveform(static_cast<float>(settings.waveform) / 3.0f);
+        engine->setMix(1.0f);
+        engine->prepareToPlay(sampleRate, blockSize);
+
+        return engine;
+    }
+
+    // Per-block microseconds over the signal, after a warm-up of two analysis windows
+    // (so every run is timed with a full set of tracks). frameInBlock receives, per
+    // timed block, whether a hop boundary (and so a synchronous frame) fell inside it.
+    std::vector<double> timeEngineBlocks(SolaireEngine& engine, const EngineSettings& settings,
+                                         const TestSignal& signal, int blockSize,
+                                         std::vector<bool>* frameInBlock = nullptr)
+    {
+        const int longestWindow = (1 << settings.fftOrder) << (settings.bands - 1);
+        const int hopSize = (1 << juce::jmin(settings.fftOrder, SolaireEngine::maxTransformOrder)) / 4;
+        const int numBlocks = static_cast<int>(signal.samples.size()) / blockSize;
+        const int warmupBlocks = juce::jmin(numBlocks / 2, (2 * longestWindow + blockSize - 1) / blockSize);
+
+        std::vector<float> output(static_cast<size_t>(blockSize));
+        std::vector<double> times;
+        times.reserve(static_cast<size_t>(numBlocks));
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            const float* input = signal.samples.data() + static_cast<size_t>(block) * static_cast<size_t>(blockSize);
+
+            const double micros = timeCallMicroseconds([&] {
+                engine.processBlock(input, output.data(), blockSize);
+            });
+
+            if (block < warmupBlocks)
+                continue;
+
+            times.push_back(micros);
+
+            // The engine's hop counter starts at zero in prepareToPlay(); with blockSize
+            // dividing hopSize, a frame completes exactly at the end of these blocks
+            if (frameInBlock != nullptr)
+                frameInBlock->push_back(((block + 1) * blockSize) % hopSize == 0);
+        }
+
+        return times;
+    }
+
+    void printEngineHeader()
+    {
+        std::cout << std::setw(7) << "order" << std::setw(8) << "voices" << std::setw(10) << "waveform"
+                  << std::setw(11) << "mode" << std::setw(11) << "ns/sample"
+                  << std::setw(11) << "block us" << std::setw(10) << "p99"
+                  << std::setw(10) << "p999" << std::setw(10) << "max" << "\n";
+    }
+
+    void runEngineCase(const EngineSettings& settings, const TestSignal& signal, int blockSize)
+    {
+        auto engine = createEngine(settings, signal.sampleRate, blockSize);
+        const auto times = timeEngineBlocks(*engine, settings, signal, blockSize);
+        const auto summary = summarise(times);
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(7) << settings.fftOrder
+                  << std::setw(8) << settings.voices
+                  << std::setw(10) << getWaveformName(settings.waveform)
+                  << std::setw(11) << getModeName(settings.mode)
+                  << std::setw(11) << summary.mean * 1000.0 / static_cast<double>(blockSize)
+                  << std::setw(11) << summary.mean
+                  << std::setw(10) << summary.p99
+                  << std::setw(10) << summary.p999
+                  << std::setw(10) << summary.max << "\n";
+    }
+
+    void benchmarkEngine(const BenchOptions& options, const TestSignal& signal)
+    {
+        const int blockSize = options.blockSize;
+
+        std::cout << "SolaireEngine::processBlock (" << signal.name.toRawUTF8() << ", "
+                  << static_cast<int>(signal.sampleRate) << " Hz, " << blockSize
+                  << "-sample blocks; block times in us)\n";
+        printEngineHeader();
+
+        // TIME: every FFT order (SLICE only reaches 7-9 at low sample rates)
+        for (int order = SolaireEngine::minFFTOrder; order <= SolaireEngine::maxFFTOrder; ++order)
+            runEngineCase({ order, 33, 0, SolaireEngine::AnalysisMode::synchronous }, signal, blockSize);
+
+        std::cout << "\n";
+
+        // VOICES at a short and a long window
+        for (int order : { 9, 13 })
+            for (int voices : { 1, 8, 16, 24 })
+                runEngineCase({ order, voices, 0, SolaireEngine::AnalysisMode::synchronous }, signal, blockSize);
+
+        std::cout << "\n";
+
+        // Every waveform (sine is the polynomial path, the rest read wavetables)
+        for (int waveform = 0; waveform < 4; ++waveform)
+            runEngineCase({ 11, 33, waveform, SolaireEngine::AnalysisMode::synchronous }, signal, blockSize);
+
+        std::cout << "\n";
+
+        // Analysis modes at the largest FFT, where worst-case blocks differ most
+        for (auto mode : { SolaireEngine::AnalysisMode::synchronous,
+                           SolaireEngine::AnalysisMode::asynchronous,
+                           SolaireEngine::AnalysisMode::amortised })
+            runEngineCase({ SolaireEngine::maxTransformOrder, 33, 0, mode }, signal, blockSize);
+
+        std::cout << "\n";
+    }
+
+    //==============================================================================
+    // Per-call cost of the analysis stages on the frames of one signal
+    void benchmarkAnalysisStages(const TestSignal& signal, int order, int maxFrames)
+    {
+        constexpr int maxPeaks = PartialTrackingEngine::MAX_TRACKS;
+        const int fftSize = 1 << order;
+        const int hopSize = fftSize / 4;
+        const int numBins = fftSize / 2 + 1;
+        const int numFrames = juce::jmin(maxFrames,
+                                         (static_cast<int>(signal.samples.size()) - fftSize) / hopSize + 1);
+
+        if (numFrames <= 0)
+            return;
+
+        FFTBackend fft(order);  // The build's backend, as in the engine
+        juce::dsp::WindowingFunction<float> window(static_cast<size_t>(fftSize),
+                                                   juce::dsp::WindowingFunction<float>::hann, false);
+        std::vector<float> fftBuffer(static_cast<size_t>(fftSize * 2));
+        std::vector<float> powerScratch(static_cast<size_t>(numBins * 2));
+
+        std::vector<std::array<SpectralPeak, maxPeaks>> framePeaks(static_cast<size_t>(numFrames));
+        std::vector<int> framePeakCounts(static_cast<size_t>(numFrames));
+        std::vector<double> fftTimes, peakTimes, trackingTimes;
+
+        for (int frame = 0; frame < numFrames; ++frame)
+        {
+            const float* input = signal.samples.data() + static_cast<size_t>(frame) * static_cast<size_t>(hopSize);
+            std::copy(input, input + fftSize, fftBuffer.begin());
+
+            fftTimes.push_back(timeCallMicroseconds([&] {
+                window.multiplyWithWindowingTable(fftBuffer.data(), static_cast<size_t>(fftSize));
+                fft.performRealForward(fftBuffer.data());
+            }));
+
+            const auto index = static_cast<size_t>(frame);
+            peakTimes.push_back(timeCallMicroseconds([&] {
+                framePeakCounts[index] = extractDominantPeaks(fftBuffer.data(), numBins, maxPeaks,
+                                                              signal.sampleRate, fftSize,
+                                                              powerScratch.data(), framePeaks[index].data());
+            }));
+        }
+
+        // Tracking runs over the frames in order, as it would in the engine
+        PartialTrackingEngine tracker;
+
+        for (int frame = 0; frame < numFrames; ++frame)
+        {
+            const auto index = static_cast<size_t>(frame);
+            trackingTimes.push_back(timeCallMicroseconds([&] {
+                tracker.processFrame(framePeaks[index].data(), framePeakCounts[index]);
+            }));
+        }
+
+        const auto fftSummary = summarise(fftTimes);
+        const auto peakSummary = summarise(peakTimes);
+        const auto trackingSummary = summarise(trackingTimes);
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(7) << order << std::setw(11) << signal.name.toRawUTF8()
+                  << std::setw(8) << numFrames
+                  << std::setw(10) << fftSummary.mean << std::setw(9) << fftSummary.p99
+                  << std::setw(10) << peakSummary.mean << std::setw(9) << peakSummary.p99
+                  << std::setw(10) << trackingSummary.mean << std::setw(9) << trackingSummary.p99 << "\n";
+    }
+
+    // Whole SolaireEngine::processFrame() as the engine runs it: blocks small enough
+    // to hold at most one hop boundary, frame cost = frame blocks minus other blocks
+    void benchmarkEngineFrame(const TestSignal& signal, int order)
+    {
+        constexpr int blockSize = 32;  // Divides the smallest hop (128 / 4)
+        const EngineSettings settings { order, 33, 0, SolaireEngine::AnalysisMode::synchronous };
+
+        auto engine = createEngine(settings, signal.sampleRate, blockSize);
+        std::vector<bool> frameInBlock;
+        const auto times = timeEngineBlocks(*engine, settings, signal, blockSize, &frameInBlock);
+
+        std::vector<double> frameBlocks, otherBlocks;
+
+        for (size_t i = 0; i < times.size(); ++i)
+            (frameInBlock[i] ? frameBlocks : otherBlocks).push_back(times[i]);
+
+        const auto frames = summarise(frameBlocks);
+        const double baseline = otherBlocks.empty() ? 0.0 : summarise(otherBlocks).mean;
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(7) << order << std::setw(8) << frameBlocks.size()
+                  << std::setw(10) << frames.mean - baseline
+                  << std::setw(9) << frames.p99 - baseline
+                  << std::setw(10) << frames.p999 - baseline << "\n";
+    }
+
+    void benchmarkFrames(const BenchOptions& options, const TestSignal& synthetic)
+    {
+        std::vector<TestSignal> sources { synthetic };
+
+        if (options.inputPath.isNotEmpty())
+        {
+            TestSignal recorded;
+
+            if (loadRecordedSignal(options.inputPath, options.quick ? 5.0 : 30.0, recorded))
+                sources.push_back(std::move(recorded));
+            else
+                std::cout << "Could not read " << options.inputPath.toRawUTF8() << " - recorded spectra skipped\n\n";
+        }
+
+        const int maxFrames = options.quick ? 100 : 400;
+
+        std::cout << "Analysis stages (us per call: mean / p99)\n";
+        std::cout << std::setw(7) << "order" << std::setw(11) << "source" << std::setw(8) << "frames"
+                  << std::setw(10) << "fft" << std::setw(9) << "p99"
+                  << std::setw(10) << "peaks" << std::setw(9) << "p99"
+                  << std::setw(10) << "tracking" << std::setw(9) << "p99" << "\n";
+
+        // Only the FFT sizes the engine computes (longer windows reuse the 2^14 transform)
+        for (int order = SolaireEngine::minFFTOrder; order <= SolaireEngine::maxTransformOrder; ++order)
+            for (const auto& source : sources)
+                benchmarkAnalysisStages(source, order, maxFrames);
+
+        std::cout << "\nSolaireEngine::processFrame inside the engine (" << synthetic.name.toRawUTF8()
+                  << ", us per frame over non-frame blocks)\n";
+        std::cout << std::setw(7) << "order" << std::setw(8) << "frames"
+                  << std::setw(10) << "mean" << std::setw(9) << "p99" << std::setw(10) << "p999" << "\n";
+
+        for (int order = SolaireEngine::minFFTOrder; order <= SolaireEngine::maxFFTOrder; ++order)
+            benchmarkEngineFrame(synthetic, order);
+
+        std::cout << "\n";
+    }
+
+    //==============================================================================
+    const char* getProfileStageName(int stage)
+    {
+        static const char* const names[] { "copyWindow", "fft", "peakExtraction", "tracking",
+                                           "modifiers", "oscUpdate", "oscBank", "outputEffects", "block" };
+        static_assert(std::size(names) == numProfileStages, "One name per ProfileStage");
+        return names[stage];
+    }
+
+    // Upper edge (us) of the histogram bin holding the given fraction of the calls
+    double getHistogramPercentile(const StageProfiler::StageCounters& counters, double fraction)
+    {
+        const auto target = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(counters.calls)));
+        uint64_t count = 0;
+
+        for (int bin = 0; bin < StageProfiler::numHistogramBins; ++bin)
+        {
+            count += counters.histogram[static_cast<size_t>(bin)];
+
+            if (count >= target)
+                return std::min(static_cast<double>(1 << bin), counters.maxMicroseconds);
+        }
+
+        return counters.maxMicroseconds;
+    }
+
+    // SolaireEngine's built-in counters, as a host-side monitor would read them
+    void benchmarkProfile(const BenchOptions& options, const TestSignal& signal)
+    {
+        std::cout << "SolaireEngine stage profile (" << options.blockSize
+                  << "-sample blocks, order 13; us, p99 from the log2 histogram)\n";
+
+        for (auto mode : { SolaireEngine::AnalysisMode::synchronous,
+                           SolaireEngine::AnalysisMode::asynchronous,
+                           SolaireEngine::AnalysisMode::amortised })
+        {
+            const EngineSettings settings { 13, 33, 0, mode };
+            auto engine = createEngine(settings, signal.sampleRate, options.blockSize);
+
+            if (!engine->getProfileSnapshot().enabled)
+            {
+                std::cout << "Profiling is compiled out - rebuild with SOLAIRE_ENABLE_PROFILING=ON\n\n";
+                return;
+            }
+
+            timeEngineBlocks(*engine, settings, signal, options.blockSize);
+            const auto snapshot = engine->getProfileSnapshot();
+
+            std::cout << getModeName(mode) << " (xruns: " << snapshot.xruns << ")\n";
+            std::cout << std::setw(16) << "stage" << std::setw(10) << "calls"
+                      << std::setw(10) << "last" << std::setw(10) << "p99" << std::setw(10) << "max" << "\n";
+
+            for (int stage = 0; stage < numProfileStages; ++stage)
+            {
+                const auto& counters = snapshot.stages[static_cast<size_t>(stage)];
+
+                std::cout << std::fixed << std::setprecision(2)
+                          << std::setw(16) << getProfileStageName(stage)
+                          << std::setw(10) << counters.calls
+                          << std::setw(10) << counters.lastMicroseconds
+                          << std::setw(10) << getHistogramPercentile(counters, 0.99)
+                          << std::setw(10) << counters.maxMicroseconds << "\n";
+            }
+
+            std::cout << "\n";
+        }
+    }
+
+    //==============================================================================
+    // Per-instance memory at every window order (allocation is the same at every
+    // order by design; only the frame working set follows the transform size)
+    void benchmarkMemory(const BenchOptions& options, double sampleRate)
+    {
+        std::cout << "SolaireEngine memory per instance (" << static_cast<int>(sampleRate) << " Hz; KiB)\n";
+        std::cout << std::setw(7) << "order" << std::setw(11) << "window ms" << std::setw(8) << "fft"
+                  << std::setw(12) << "decimation" << std::setw(8) << "hop"
+                  << std::setw(12) << "allocated" << std::setw(13) << "frame set" << "\n";
+
+        for (int order = SolaireEngine::minFFTOrder; order <= SolaireEngine::maxFFTOrder; ++order)
+        {
+            const int transformOrder = juce::jmin(order, SolaireEngine::maxTransformOrder);
+            auto engine = createEngine({ order, 33, 0, SolaireEngine::AnalysisMode::synchronous },
+                                       sampleRate, options.blockSize);
+            const auto footprint = engine->getMemoryFootprint();
+
+            std::cout << std::fixed << std::setprecision(1)
+                      << std::setw(7) << order
+                      << std::setw(11) << 1000.0 * static_cast<double>(1 << order) / sampleRate
+                      << std::setw(8) << (1 << transformOrder)
+                      << std::setw(12) << (1 << (order - transformOrder))
+                      << std::setw(8) << (1 << transformOrder) / 4
+                      << std::setw(12) << static_cast<double>(footprint.allocatedBytes) / 1024.0
+                      << std::setw(13) << static_cast<double>(footprint.frameWorkingSetBytes) / 1024.0 << "\n";
+        }
+
+        std::cout << "\n";
+    }
+
+    //==============================================================================
+    // Multi-resolution analysis against single windows. Four bass partials a whole tone
+    // apart (55-78 Hz) plus two upper partials are resynthesised; the output is
+    // analysed with a 2^16-point FFT and every bass partial is matched to the nearest
+    // output peak. FFT work counts N log2 N per transform, per second of audio and
+    // for the worst frame (every band due at once).
+    void benchmarkMultiResolution(const BenchOptions& options)
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int outputOrder = 16;
+        constexpr std::array<double, 4> bassPartials { 55.0, 61.74, 69.30, 77.78 };
+        constexpr std::array<double, 2> upperPartials { 440.0, 660.0 };
+        constexpr double resolvedCents = 25.0;
+
+        TestSignal signal;
+        signal.name = "bass partials";
+        signal.sampleRate = sampleRate;
+        signal.samples.resize(static_cast<size_t>((options.quick ? 4.0 : 8.0) * sampleRate));
+
+        for (size_t n = 0; n < signal.samples.size(); ++n)
+        {
+            const double t = static_cast<double>(n) / sampleRate;
+            double value = 0.0;
+
+            for (double frequency : bassPartials)
+                value += 0.15 * std::sin(juce::MathConstants<double>::twoPi * frequency * t);
+
+            for (double frequency : upperPartials)
+                value += 0.1 * std::sin(juce::MathConstants<double>::twoPi * frequency * t);
+
+            signal.samples[n] = static_cast<float>(value);
+        }
+
+        std::cout << "Multi-resolution analysis (" << static_cast<int>(sampleRate) << " Hz, "
+                  << options.blockSize << "-sample blocks; bass error in cents, FFT work in N log2 N)\n";
+        std::cout << std::setw(7) << "order" << std::setw(7) << "bands" << std::setw(12) << "bass window"
+                  << std::setw(12) << "top window" << std::setw(13) << "work M/s" << std::setw(13) << "worst frame"
+                  << std::setw(11) << "ns/sample" << std::setw(11) << "bass err" << std::setw(10) << "resolved" << "\n";
+
+        struct Case { int order; int bands; };
+
+        for (const auto& testCase : { Case { 11, 1 }, Case { 14, 1 }, Case { 11, 4 }, Case { 12, 3 } })
+        {
+            const EngineSettings settings { testCase.order, 33, 0, SolaireEngine::AnalysisMode::synchronous, testCase.bands };
+            auto engine = createEngine(settings, sampleRate, options.blockSize);
+            engine->setCenterFreq(0.383f);  // Frequency window ~50 Hz - 1.6 kHz
+
+            const int blockSize = options.blockSize;
+            const int numBlocks = static_cast<int>(signal.samples.size()) / blockSize;
+            std::vector<float> output(signal.samples.size(), 0.0f);
+            double totalMicros = 0.0;
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                const auto offset = static_cast<size_t>(block) * static_cast<size_t>(blockSize);
+
+                totalMicros += timeCallMicroseconds([&] {
+                    engine->processBlock(signal.samples.data() + offset, output.data() + offset, blockSize);
+                });
+            }
+
+            // Peaks of the last 2^16 output samples
+            const int outputSize = 1 << outputOrder;
+            const auto analysisStart = static_cast<size_t>(numBlocks * blockSize - outputSize);
+            juce::dsp::FFT fft(outputOrder);
+            juce::dsp::WindowingFunction<float> window(static_cast<size_t>(outputSize) + 1,
+                                                       juce::dsp::WindowingFunction<float>::hann, false);
+            std::vector<float> spectrum(static_cast<size_t>(outputSize) * 2, 0.0f);
+
+            std::copy_n(output.begin() + static_cast<std::ptrdiff_t>(analysisStart), outputSize, spectrum.begin());
+            window.multiplyWithWindowingTable(spectrum.data(), static_cast<size_t>(outputSize));
+            fft.performRealOnlyForwardTransform(spectrum.data(), true);
+
+            const auto peaks = extractDominantPeaks(spectrum.data(), outputSize / 2 + 1, 64, sampleRate, outputSize);
+
+            double totalError = 0.0;
+            int numResolved = 0;
+
+            for (double frequency : bassPartials)
+            {
+                double error = 1200.0;
+
+                for (const auto& peak : peaks)
+                    error = std::min(error, std::abs(1200.0 * std::log2(static_cast<double>(peak.frequency) / frequency)));
+
+                totalError += error;
+                numResolved += (error <= resolvedCents) ? 1 : 0;
+            }
+
+            // FFT work: band k transforms the same size every 2^k hops
+            const int transformOrder = juce::jmin(testCase.order, SolaireEngine::maxTransformOrder);
+            const double transformWork = static_cast<double>(1 << transformOrder) * transformOrder;
+            const double hopSize = static_cast<double>(1 << transformOrder) / 4.0;
+            double workPerSecond = 0.0;
+
+            for (int band = 0; band < testCase.bands; ++band)
+                workPerSecond += transformWork * sampleRate / (hopSize * static_cast<double>(1 << band));
+
+            std::cout << std::fixed << std::setprecision(1)
+                      << std::setw(7) << testCase.order
+                      << std::setw(7) << testCase.bands
+                      << std::setw(12) << 1000.0 * static_cast<double>((1 << testCase.order) << (testCase.bands - 1)) / sampleRate
+                      << std::setw(12) << 1000.0 * static_cast<double>(1 << testCase.order) / sampleRate
+                      << std::setw(13) << workPerSecond / 1.0e6
+                      << std::setw(13) << transformWork * testCase.bands
+                      << std::setw(11) << totalMicros * 1000.0 / static_cast<double>(numBlocks * blockSize)
+                      << std::setw(11) << totalError / static_cast<double>(bassPartials.size())
+                      << std::setw(10) << numResolved << "\n";
+        }
+
+        std::cout << "\n";
+    }
+
+    //==============================================================================
+    // Oscillator bank capacities: numSounding voices of the bank sounding (log-spaced
+    // partials, every voice by default), rendered in host-sized blocks with a hop-rate
+    // update, per render kernel. Sparse sets are spread over every slot, as the
+    // tracker leaves them.
+    template <int Capacity>
+    double timeBankNanosPerSample(int waveform, double sampleRate, int blockSize, int numBlocks,
+                                  int numSounding = Capacity)
+    {
+        BasicOscillatorBank<Capacity> bank;
+        bank.prepare({ sampleRate, static_cast<juce::uint32>(blockSize), 1 });
+        bank.setWaveform(waveform);
+
+        std::array<PartialTrack, Capacity> partials;
+        const int slotStride = juce::jmax(1, Capacity / juce::jmax(1, numSounding));
+
+        for (int i = 0; i < Capacity; ++i)
+        {
+            const float position = static_cast<float>(i) / static_cast<float>(Capacity);
+            partials[static_cast<size_t>(i)] = PartialTrack(i, SpectralPeak(40.0f * std::pow(300.0f, position), 0.5f, 0.0f, 0));
+            partials[static_cast<size_t>(i)].isActive = (i % slotStride == 0) && (i / slotStride < numSounding);
+        }
+
+        std::vector<float> output(static_cast<size_t>(blockSize));
+        bank.updateFromPartials(partials.data(), Capacity, Capacity);
+
+        const double micros = timeMicroseconds(numBlocks, [&] {
+            bank.updateFromPartials(partials.data(), Capacity, Capacity);
+            bank.processBlock(output.data(), blockSize);
+        });
+
+        return micros * 1000.0 / static_cast<double>(blockSize);
+    }
+
+    void benchmarkCapacity(const BenchOptions& options, const TestSignal& signal)
+    {
+        const int blockSize = options.blockSize;
+        const int numBlocks = static_cast<int>((options.quick ? 2.0 : 6.0) * signal.sampleRate) / blockSize;
+
+        std::cout << "Oscillator bank capacities (" << static_cast<int>(signal.sampleRate) << " Hz, "
+                  << blockSize << "-sample blocks, every voice sounding; ns per output sample)\n";
+        std::cout << std::setw(10) << "capacity" << std::setw(10) << "kernel" << std::setw(11) << "ns/sample"
+                  << std::setw(11) << "vs 33" << "\n";
+
+        for (int waveform : { 0, 2 })
+        {
+            const double reference = timeBankNanosPerSample<33>(waveform, signal.sampleRate, blockSize, numBlocks);
+
+            auto printCase = [&](int capacity, double nanos) {
+                std::cout << std::fixed << std::setprecision(2)
+                          << std::setw(10) << capacity
+                          << std::setw(10) << (waveform == 0 ? "sine" : "table")
+                          << std::setw(11) << nanos
+                          << std::setw(11) << nanos / reference << "\n";
+            };
+
+            printCase(8, timeBankNanosPerSample<8>(waveform, signal.sampleRate, blockSize, numBlocks));
+            printCase(16, timeBankNanosPerSample<16>(waveform, signal.sampleRate, blockSize, numBlocks));
+            printCase(33, reference);
+            printCase(256, timeBankNanosPerSample<256>(waveform, signal.sampleRate, blockSize, numBlocks));
+        }
+
+        // Active-voice compaction: a 256-voice bank only renders the voices that sound
+        std::cout << "\n256-voice bank by sounding voices (spread over all slots; vs 33 = the full 33-voice bank)\n";
+        std::cout << std::setw(10) << "sounding" << std::setw(10) << "kernel" << std::setw(11) << "ns/sample"
+                  << std::setw(11) << "vs 33" << "\n";
+
+        for (int waveform : { 0, 2 })
+        {
+            const double reference = timeBankNanosPerSample<33>(waveform, signal.sampleRate, blockSize, numBlocks);
+
+            for (int sounding : { 8, 33, 128, 256 })
+            {
+                const double nanos = timeBankNanosPerSample<256>(waveform, signal.sampleRate, blockSize, numBlocks, sounding);
+                std::cout << std::fixed << std::setprecision(2)
+                          << std::setw(10) << sounding
+                          << std::setw(10) << (waveform == 0 ? "sine" : "table")
+                          << std::setw(11) << nanos
+                          << std::setw(11) << nanos / reference << "\n";
+            }
+        }
+
+        // The engine picks the smallest capacity that holds VOICES at each block boundary
+        std::cout << "\nEngine by VOICES (the engine selects the 8 / 16 / 33-voice bank)\n";
+        printEngineHeader();
+
+        for (int voices : { 8, 16, 33 })
+            runEngineCase({ 11, voices, 0, SolaireEngine::AnalysisMode::synchronous }, signal, blockSize);
+
+        std::cout << "\n";
+    }
+
+    //==============================================================================
+    // Synthesis backends: the inverse-FFT synthesiser against oscillator banks of the
+    // same partial count (banks past 128 voices are instantiated here only, to show
+    // where the lines cross)
+    double timeInverseFFTNanosPerSample(int numPartials, int waveform, double sampleRate, int blockSize, int numBlocks)
+    {
+        InverseFFTSynthesiser synthesiser;
+        synthesiser.prepare({ sampleRate, static_cast<juce::uint32>(blockSize), 1 });
+        synthesiser.setWaveform(waveform);
+
+        std::vector<PartialTrack> partials;
+
+        for (int i = 0; i < numPartials; ++i)
+        {
+            const float position = static_cast<float>(i) / static_cast<float>(numPartials);
+            partials.emplace_back(i, SpectralPeak(40.0f * std::pow(300.0f, position), 0.5f, 0.0f, 0));
+        }
+
+        std::vector<float> output(static_cast<size_t>(blockSize));
+        synthesiser.updateFromPartials(partials.data(), numPartials, numPartials);
+
+        const double micros = timeMicroseconds(numBlocks, [&] {
+            synthesiser.updateFromPartials(partials.data(), numPartials, numPartials);
+            synthesiser.processBlock(output.data(), blockSize);
+        });
+
+        return micros * 1000.0 / static_cast<double>(blockSize);
+    }
+
+    void benchmarkSynthesis(const BenchOptions& options, const TestSignal& signal)
+    {
+        const int blockSize = options.blockSize;
+        const int numBlocks = static_cast<int>((options.quick ? 2.0 : 6.0) * signal.sampleRate) / blockSize;
+
+        std::cout << "Synthesis backends (" << static_cast<int>(signal.sampleRate) << " Hz, " << blockSize
+                  << "-sample blocks, every partial sounding; ns per output sample)\n";
+        std::cout << std::setw(10) << "partials" << std::setw(10) << "waveform" << std::setw(11) << "bank"
+                  << std::setw(11) << "ifft" << std::setw(11) << "ifft/bank" << "\n";
+
+        for (int waveform : { 0, 2 })
+        {
+            auto printCase = [&](int numPartials, double bankNanos) {
+                const double inverseNanos = timeInverseFFTNanosPerSample(numPartials, waveform, signal.sampleRate,
+                                                                         blockSize, numBlocks);
+                std::cout << std::fixed << std::setprecision(2)
+                          << std::setw(10) << numPartials
+                          << std::setw(10) << (waveform == 0 ? "sine" : "saw")
+                          << std::setw(11) << bankNanos
+                          << std::setw(11) << inverseNanos
+                          << std::setw(11) << inverseNanos / bankNanos << "\n";
+            };
+
+            printCase(33, timeBankNanosPerSample<33>(waveform, signal.sampleRate, blockSize, numBlocks));
+            printCase(128, timeBankNanosPerSample<128>(waveform, signal.sampleRate, blockSize, numBlocks));
+            printCase(256, timeBankNanosPerSample<256>(waveform, signal.sampleRate, blockSize, numBlocks));
+            printCase(512, timeBankNanosPerSample<512>(waveform, signal.sampleRate, blockSize, numBlocks));
+        }
+
+        std::cout << "\n";
+    }
+
+    //==============================================================================
+    // Quality governor: the budget is first set to half the engine's ungoverned p99
+    // block time, so full quality misses it, then opened to the whole block so the
+    // tiers come back one by one. One line per half second of audio.
+    void benchmarkGovernor(const BenchOptions& options, const TestSignal& signal)
+    {
+        static const char* const tierNames[] { "full", "reduced voices", "reduced overlap", "no modifiers" };
+
+        const EngineSettings settings { 13, 33, 0, SolaireEngine::AnalysisMode::synchronous };
+        const int blockSize = options.blockSize;
+        const double blockSeconds = static_cast<double>(blockSize) / signal.sampleRate;
+
+        auto reference = createEngine(settings, signal.sampleRate, blockSize);
+        const auto ungoverned = summarise(timeEngineBlocks(*reference, settings, signal, blockSize));
+        const double tightBudget = juce::jlimit(0.01, 1.0, 0.5 * ungoverned.p99 * 1.0e-6 / blockSeconds);
+
+        std::cout << "Quality governor (order 13, 33 voices, sync, " << blockSize << "-sample blocks; "
+                  << "ungoverned p99 " << std::fixed << std::setprecision(1) << ungoverned.p99 << " us)\n";
+        std::cout << std::setw(8) << "time s" << std::setw(10) << "budget" << std::setw(18) << "tier"
+                  << std::setw(11) << "last load" << std::setw(12) << "max us" << "\n";
+
+        auto engine = createEngine(settings, signal.sampleRate, blockSize);
+        std::vector<float> output(static_cast<size_t>(blockSize));
+
+        const int numSignalBlocks = static_cast<int>(signal.samples.size()) / blockSize;
+        const int reportBlocks = static_cast<int>(0.5 / blockSeconds);
+        int signalBlock = 0;
+        double elapsed = 0.0;
+
+        struct Phase { double budget; double seconds; };
+
+        for (const auto& phase : { Phase { tightBudget, 3.0 }, Phase { 1.0, 8.0 } })
+        {
+            engine->setQualityGovernor(true, phase.budget);
+
+            const int numBlocks = static_cast<int>(phase.seconds / blockSeconds);
+            double windowMax = 0.0;
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                const float* input = signal.samples.data() + static_cast<size_t>(signalBlock) * static_cast<size_t>(blockSize);
+                signalBlock = (signalBlock + 1) % numSignalBlocks;
+
+                windowMax = std::max(windowMax, timeCallMicroseconds([&] {
+                    engine->processBlock(input, output.data(), blockSize);
+                }));
+
+                elapsed += blockSeconds;
+
+                if ((block + 1) % reportBlocks == 0)
+                {
+                    std::cout << std::fixed << std::setprecision(2)
+                              << std::setw(8) << elapsed
+                              << std::setw(10) << phase.budget
+                              << std::setw(18) << tierNames[static_cast<int>(engine->getQualityTier())]
+                              << std::setw(11) << engine->getGovernorLoad()
+                              << std::setw(12) << windowMax << "\n";
+                    windowMax = 0.0;
+                }
+            }
+        }
+
+        std::cout << "\n";
+    }
+
+    //==============================================================================
+    // FFT backends: the frame copy out of the input ring (two-part copy then window,
+    // as before the ring was mirrored, against the fused windowed copy) and JuceFFTBackend
+    // against the build's FFTBackend, real and complex, with the largest bin difference
+    template <typename Backend>
+    double timeRealTransformNanos(Backend& backend, const std::vector<float>& frame, std::vector<float>& buffer, int iterations)
+    {
+        return 1000.0 * timeMicroseconds(iterations, [&] {
+            std::copy(frame.begin(), frame.end(), buffer.begin());
+            backend.performRealForward(buffer.data());
+        });
+    }
+
+    void benchmarkFFTBackends(const BenchOptions& options, const TestSignal& signal)
+    {
+        constexpr bool compareBackends = !std::is_same_v<FFTBackend, JuceFFTBackend>;
+        constexpr int ringSize = 32768;  // As SolaireEngine's input ring
+
+        std::cout << "FFT backends (selected: " << FFTBackend::name << "; ns per frame; max diff relative to "
+                  << "the largest JUCE bin)\n";
+        std::cout << std::setw(7) << "order" << std::setw(12) << "copy+win" << std::setw(10) << "fused"
+                  << std::setw(12) << "juce real" << std::setw(12) << "real" << std::setw(14) << "juce complex"
+                  << std::setw(12) << "complex" << std::setw(12) << "max diff" << "\n";
+
+        // A ring holding the signal twice over its length, read at a wrapping frame start
+        std::vector<float> ring(static_cast<size_t>(2 * ringSize));
+
+        for (int i = 0; i < ringSize; ++i)
+            ring[static_cast<size_t>(i)] = ring[static_cast<size_t>(i + ringSize)]
+                = signal.samples[static_cast<size_t>(i) % signal.samples.size()];
+
+        for (int order = SolaireEngine::minFFTOrder; order <= SolaireEngine::maxTransformOrder; ++order)
+        {
+            const int size = 1 << order;
+            const int iterations = juce::jmax(20, (options.quick ? 1 << 19 : 1 << 21) / size);
+            const int frameStart = ringSize - size / 2;  // Wraps half-way through the frame
+
+            std::vector<float> window(static_cast<size_t>(size));
+            for (int i = 0; i < size; ++i)
+                window[static_cast<size_t>(i)] = static_cast<float>(
+                    0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * i / static_cast<double>(size)));
+
+            std::vector<float> frame(static_cast<size_t>(size) * 2, 0.0f);
+            std::vector<float> buffer(static_cast<size_t>(size) * 2, 0.0f);
+
+            const double copyNanos = 1000.0 * timeMicroseconds(iterations, [&] {
+                const int firstPart = ringSize - frameStart;
+                std::memcpy(frame.data(), ring.data() + frameStart, static_cast<size_t>(firstPart) * sizeof(float));
+                std::memcpy(frame.data() + firstPart, ring.data(), static_cast<size_t>(size - firstPart) * sizeof(float));
+                juce::FloatVectorOperations::multiply(frame.data(), window.data(), size);
+            });
+
+            const double fusedNanos = 1000.0 * timeMicroseconds(iterations, [&] {
+                juce::FloatVectorOperations::multiply(frame.data(), ring.data() + frameStart, window.data(), size);
+            });
+
+            // Real frames (the windowed signal), complex frames (L + iR from two offsets)
+            std::vector<float> realFrame(frame.begin(), frame.begin() + size);
+            realFrame.resize(static_cast<size_t>(size) * 2, 0.0f);
+            std::vector<std::complex<float>> complexFrame(static_cast<size_t>(size));
+            std::vector<std::complex<float>> complexOutput(static_cast<size_t>(size));
+
+            for (int i = 0; i < size; ++i)
+                complexFrame[static_cast<size_t>(i)] = { frame[static_cast<size_t>(i)],
+                                                         frame[static_cast<size_t>((i + size / 3) % size)] };
+
+            JuceFFTBackend juceFFT(order);
+            const double juceRealNanos = timeRealTransformNanos(juceFFT, realFrame, buffer, iterations);
+            const double juceComplexNanos = 1000.0 * timeMicroseconds(iterations, [&] {
+                juceFFT.performComplexForward(complexFrame.data(), complexOutput.data());
+            });
+
+            std::cout << std::fixed << std::setprecision(0)
+                      << std::setw(7) << order << std::setw(12) << copyNanos << std::setw(10) << fusedNanos
+                      << std::setw(12) << juceRealNanos;
+
+            if constexpr (compareBackends)
+            {
+                std::copy(realFrame.begin(), realFrame.end(), buffer.begin());
+                juceFFT.performRealForward(buffer.data());
+                const std::vector<float> reference(buffer.begin(), buffer.begin() + size + 2);
+                const auto referenceComplex = complexOutput;
+
+                FFTBackend selectedFFT(order);
+                const double realNanos = timeRealTransformNanos(selectedFFT, realFrame, buffer, iterations);
+                const double complexNanos = 1000.0 * timeMicroseconds(iterations, [&] {
+                    selectedFFT.performComplexForward(complexFrame.data(), complexOutput.data());
+                });
+
+                // Bins 0..size/2 of the real transform and every complex bin
+                std::copy(realFrame.begin(), realFrame.end(), buffer.begin());
+                selectedFFT.performRealForward(buffer.data());
+
+                double largest = 0.0, maxDifference = 0.0;
+
+                for (int i = 0; i < size + 2; ++i)
+                {
+                    largest = std::max(largest, static_cast<double>(std::abs(reference[static_cast<size_t>(i)])));
+                    maxDifference = std::max(maxDifference, static_cast<double>(std::abs(reference[static_cast<size_t>(i)]
+                                                                                         - buffer[static_cast<size_t>(i)])));
+                }
+
+                for (int i = 0; i < size; ++i)
+                    maxDifference = std::max(maxDifference, static_cast<double>(std::abs(referenceComplex[static_cast<size_t>(i)]
+                                                                                         - complexOutput[static_cast<size_t>(i)])));
+
+                std::cout << std::setw(12) << realNanos << std::setw(14) << juceComplexNanos << std::setw(12) << complexNanos
+                          << std::setw(12) << std::scientific << std::setprecision(1) << maxDifference / std::max(largest, 1.0e-30)
+                          << std::fixed << "\n";
+            }
+            else
+            {
+                std::cout << std::setw(12) << "-" << std::setw(14) << juceComplexNanos << std::setw(12) << "-"
+                          << std::setw(12) << "-" << "\n";
+            }
+        }
+
+        if constexpr (!compareBackends)
+            std::cout << "(configure with -DSOLAIRE_FFT_BACKEND=pffft|fftw|vdsp|ipp to compare another backend)\n";
+
+        std::cout << std::defaultfloat << "\n";
+    }
+
+    //==============================================================================
+    // Sleep mode: the signal, then silence long enough for the voices to release,
+    // then the signal again - one engine with sleep mode, one without
+    void benchmarkSleep(const BenchOptions& options, const TestSignal& signal)
+    {
+        const EngineSettings settings { 13, 33, 0, SolaireEngine::AnalysisMode::synchronous };
+        const int blockSize = options.blockSize;
+        const double blockSeconds = static_cast<double>(blockSize) / signal.sampleRate;
+
+        auto awakeEngine = createEngine(settings, signal.sampleRate, blockSize);
+        auto sleepingEngine = createEngine(settings, signal.sampleRate, blockSize);
+        awakeEngine->setSleepEnabled(false);
+
+        std::cout << "Sleep mode (order 13, 33 voices, sync, " << blockSize
+                  << "-sample blocks; reported tail "  << std::fixed << std::setprecision(2)
+                  << SolaireEngine::getTailLengthSeconds(signal.sampleRate, sleepingEngine->getLatencyInSamples(),
+                                                         SolaireEngine::Parameters{}.glide)
+                  << " s)\n";
+        std::cout << std::setw(8) << "time s" << std::setw(10) << "input" << std::setw(14) << "awake ns/s"
+                  << std::setw(14) << "sleep ns/s" << std::setw(10) << "asleep" << std::setw(14) << "max diff" << "\n";
+
+        std::vector<float> silence(static_cast<size_t>(blockSize), 0.0f);
+        std::vector<float> awakeOutput(static_cast<size_t>(blockSize));
+        std::vector<float> sleepingOutput(static_cast<size_t>(blockSize));
+
+        const int numSignalBlocks = static_cast<int>(signal.samples.size()) / blockSize;
+        const int reportBlocks = static_cast<int>(1.0 / blockSeconds);
+        int signalBlock = 0;
+        double elapsed = 0.0;
+
+        struct Phase { bool silent; double seconds; };
+
+        for (const auto& phase : { Phase { false, 2.0 }, Phase { true, options.quick ? 6.0 : 10.0 }, Phase { false, 2.0 } })
+        {
+            const int numBlocks = static_cast<int>(phase.seconds / blockSeconds);
+            double awakeMicros = 0.0, sleepingMicros = 0.0, maxDifference = 0.0;
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                const float* input = phase.silent ? silence.data()
+                                                  : signal.samples.data() + static_cast<size_t>(signalBlock) * static_cast<size_t>(blockSize);
+                signalBlock = (signalBlock + 1) % numSignalBlocks;
+
+                awakeMicros += timeCallMicroseconds([&] { awakeEngine->processBlock(input, awakeOutput.data(), blockSize); });
+                sleepingMicros += timeCallMicroseconds([&] { sleepingEngine->processBlock(input, sleepingOutput.data(), blockSize); });
+
+                for (int i = 0; i < blockSize; ++i)
+                    maxDifference = std::max(maxDifference, static_cast<double>(std::abs(awakeOutput[static_cast<size_t>(i)]
+                                                                                         - sleepingOutput[static_cast<size_t>(i)])));
+
+                elapsed += blockSeconds;
+
+                if ((block + 1) % reportBlocks == 0)
+                {
+                    const double samples = static_cast<double>(reportBlocks * blockSize);
+
+                    std::cout << std::fixed << std::setprecision(1)
+                              << std::setw(8) << elapsed
+                              << std::setw(10) << (phase.silent ? "silent" : "signal")
+                              << std::setw(14) << awakeMicros * 1000.0 / samples
+                              << std::setw(14) << sleepingMicros * 1000.0 / samples
+                              << std::setw(10) << (sleepingEngine->isSleeping() ? "yes" : "no")
+                              << std::setw(14) << std::scientific << std::setprecision(1) << maxDifference << "\n";
+                    awakeMicros = sleepingMicros = maxDifference = 0.0;
+                }
+            }
+        }
+
+        std::cout << std::defaultfloat << "\n";
+    }
+
+    //==============================================================================
+    // FLOAT: the shared stereo stage against the former per-engine reverbs (one mono
+    // juce::Reverb per channel, its parameters rebuilt on every call)
+    void benchmarkFloatReverb(const BenchOptions& options, const TestSignal& signal)
+    {
+        const int blockSize = options.blockSize;
+        const int numBlocks = static_cast<int>(signal.samples.size()) / blockSize;
+
+        std::vector<float> left(signal.samples), right(signal.samples);
+        std::reverse(right.begin(), right.end());  // Decorrelated second channel
+
+        std::cout << "FLOAT reverb (stereo, " << blockSize << "-sample blocks, ns per sample frame)\n";
+        std::cout << std::setw(8) << "FLOAT" << std::setw(16) << "mono x2" << std::setw(16) << "FloatReverb" << "\n";
+
+        for (float floatAmount : { 0.0f, 0.25f, 0.5f, 1.0f })
+        {
+            std::array<juce::Reverb, 2> monoReverbs;
+
+            for (auto& reverb : monoReverbs)
+                reverb.setSampleRate(signal.sampleRate);
+
+            FloatReverb stage;
+            stage.prepare(signal.sampleRate, juce::AudioChannelSet::stereo(), 2, floatAmount);
+
+            std::vector<float> monoLeft(left), monoRight(right), stageLeft(left), stageRight(right);
+            double monoMicros = 0.0, stageMicros = 0.0;
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                const size_t offset = static_cast<size_t>(block) * static_cast<size_t>(blockSize);
+                float* monoChannels[] = { monoLeft.data() + offset, monoRight.data() + offset };
+                float* stageChannels[] = { stageLeft.data() + offset, stageRight.data() + offset };
+
+                monoMicros += timeCallMicroseconds([&] {
+                    for (size_t channel = 0; channel < monoReverbs.size(); ++channel)
+                    {
+                        juce::Reverb::Parameters parameters;
+                        parameters.roomSize = floatAmount;
+                        parameters.damping = 0.5f;
+                        parameters.wetLevel = floatAmount;
+                        parameters.dryLevel = 1.0f - floatAmount;
+                        parameters.width = 1.0f;
+                        monoReverbs[channel].setParameters(parameters);
+                        monoReverbs[channel].processMono(monoChannels[channel], blockSize);
+                    }
+                });
+
+                stageMicros += timeCallMicroseconds([&] {
+                    stage.setFloat(floatAmount);
+                    stage.process(stageChannels, blockSize);
+                });
+            }
+
+            const double frames = static_cast<double>(numBlocks * blockSize);
+            std::cout << std::fixed << std::setprecision(2) << std::setw(8) << floatAmount
+                      << std::setw(16) << monoMicros * 1000.0 / frames
+                      << std::setw(16) << stageMicros * 1000.0 / frames << "\n";
+        }
+
+        std::cout << std::defaultfloat << "\n";
+    }
+
+    //==============================================================================
+    // Real-time safety: every block after prepareToPlay() runs with the audio thread
+    // armed, while the parameters sweep through everything that used to allocate
+    // (FFT order changes, voice counts, waveform tables, freeze, shelf redesigns)
+    struct SweepScript
+    {
+        int numBlocks = 0;
+
+        // Position in the run (0-1) of block 'block'
+        double at(int block) const { return static_cast<double>(block) / static_cast<double>(numBlocks); }
+
+        static float triangle(double position, double periods)
+        {
+            const double phase = position * periods - std::floor(position * periods);
+            return static_cast<float>(phase < 0.5 ? 2.0 * phase : 2.0 - 2.0 * phase);
+        }
+
+        SolaireEngine::Parameters parametersAt(double position) const
+        {
+            SolaireEngine::Parameters parameters;
+            parameters.slice = triangle(position, 1.0);                  // Every FFT order, up and down
+            parameters.voice = triangle(position, 3.0);
+            parameters.waveform = std::floor(static_cast<float>(position) * 8.0f) / 3.0f;
+            parameters.waveform -= std::floor(parameters.waveform + 0.01f);  // 0, 1/3, 2/3, 0, ...
+            parameters.freeze = (static_cast<int>(position * 10.0) % 2 == 1) ? 1.0f : 0.0f;
+            parameters.blur = triangle(position, 2.0) * 0.8f;
+            parameters.warp = triangle(position, 5.0);
+            parameters.feedback = triangle(position, 4.0) * 0.5f;
+            parameters.colour = triangle(position, 7.0);
+            parameters.mix = 0.5f + 0.5f * triangle(position, 3.5);
+            return parameters;
+        }
+
+        SolaireEngine::ParameterBlock blockAt(int block) const
+        {
+            return { parametersAt(at(block)), parametersAt(at(block + 1)) };
+        }
+
+        // Silence from 55% to 70% of the run, long enough for sleep mode
+        bool isSilent(int block) const { return at(block) >= 0.55 && at(block) < 0.7; }
+
+        float floatAt(int block) const { return triangle(at(block), 2.0) * (at(block) < 0.5 ? 0.0f : 1.0f); }
+    };
+
+    struct GuardedRun
+    {
+        AudioThreadGuard::Counts counts;
+        TimingSummary timing;                 // Microseconds per block
+        std::vector<float> output;            // First channel
+        bool slept = false;
+        int enginesPerThread = 1;             // Engines run back to back on one thread
+    };
+
+    GuardedRun runGuardedEngine(const BenchOptions& options, const TestSignal& signal, SolaireEngine::AnalysisMode mode,
+                                SolaireEngine::SynthesisBackend backend, bool linked, int numBlocks)
+    {
+        const int blockSize = options.blockSize;
+        const int numSignalBlocks = static_cast<int>(signal.samples.size()) / blockSize;
+        const SweepScript script { numBlocks };
+
+        SolaireEngine::SnapshotBank snapshots;
+        SolaireEngine leader, follower;
+        FloatReverb floatReverb;
+
+        for (auto* engine : { &leader, &follower })
+        {
+            engine->setSynthesisBackend(backend);
+            engine->setSnapshotBank(&snapshots);
+        }
+
+        leader.setAnalysisMode(mode);
+        leader.setChannelLink(linked ? SolaireEngine::ChannelLink::maxMagnitude : SolaireEngine::ChannelLink::independent,
+                              linked ? &follower : nullptr);
+        follower.setAnalysisMode(SolaireEngine::AnalysisMode::synchronous);
+
+        const int numChannels = linked ? 2 : 1;
+        leader.prepareToPlay(signal.sampleRate, blockSize);
+        follower.prepareToPlay(signal.sampleRate, blockSize);
+        floatReverb.prepare(signal.sampleRate, juce::AudioChannelSet::canonicalChannelSet(numChannels), numChannels, 0.0f);
+
+        GuardedRun run;
+        run.output.resize(static_cast<size_t>(numBlocks) * static_cast<size_t>(blockSize));
+
+        std::vector<float> silence(static_cast<size_t>(blockSize), 0.0f);
+        std::vector<float> rightInput(static_cast<size_t>(blockSize)), rightOutput(static_cast<size_t>(blockSize));
+        std::vector<double> times;
+        times.reserve(static_cast<size_t>(numBlocks));
+
+        const int warmupBlocks = static_cast<int>(signal.sampleRate) / blockSize;  // Not timed (page faults)
+        AudioThreadGuard::resetCounts();
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            const float* input = script.isSilent(block) ? silence.data()
+                                                        : signal.samples.data() + static_cast<size_t>(block % numSignalBlocks)
+                                                                                      * static_cast<size_t>(blockSize);
+            float* output = run.output.data() + static_cast<size_t>(block) * static_cast<size_t>(blockSize);
+
+            // A second channel: the first one half a block later, scaled
+            for (int i = 0; i < blockSize; ++i)
+                rightInput[static_cast<size_t>(i)] = 0.7f * input[(i + blockSize / 2) % blockSize];
+
+            const auto parameters = script.blockAt(block);
+
+            const double micros = timeCallMicroseconds([&] {
+                const AudioThreadGuard::ScopedArm arm;
+
+                leader.setParameters(parameters);
+
+                if (linked)
+                {
+                    follower.setParameters(parameters);
+                    leader.processLinkedBlock(input, rightInput.data(), output, rightOutput.data(), blockSize);
+                }
+                else
+                {
+                    leader.processBlock(input, output, blockSize);
+                }
+
+                float* channels[] = { output, rightOutput.data() };
+                floatReverb.setFloat(script.floatAt(block));
+                floatReverb.process(channels, blockSize);
+
+                // Snapshots: capture, recall and release while frozen and not
+                if (block == static_cast<int>(0.2 * numBlocks)) leader.captureSnapshot(0);
+                if (block == static_cast<int>(0.3 * numBlocks)) leader.recallSnapshot(0);
+                if (block == static_cast<int>(0.4 * numBlocks)) leader.releaseSnapshot();
+            });
+
+            run.slept = run.slept || leader.isSleeping();
+
+            if (block >= warmupBlocks)
+                times.push_back(micros);
+        }
+
+        run.counts = AudioThreadGuard::getCounts();
+        run.timing = summarise(times);
+        return run;
+    }
+
+    // A multichannel layout's engines run as groups on the ChannelWorkerPool, the
+    // guarded thread joining in as the processor's audio thread does (one worker
+    // fewer than the cores, as the processor sizes its pool)
+    GuardedRun runGuardedPool(const BenchOptions& options, const TestSignal& signal, int numEngines, int numBlocks)
+    {
+        const int blockSize = options.blockSize;
+        const int numSignalBlocks = static_cast<int>(signal.samples.size()) / blockSize;
+        const SweepScript script { numBlocks };
+
+        std::vector<std::unique_ptr<SolaireEngine>> engines;
+        std::vector<std::vector<float>> outputs(static_cast<size_t>(numEngines),
+                                                std::vector<float>(static_cast<size_t>(blockSize)));
+
+        for (int i = 0; i < numEngines; ++i)
+        {
+            engines.push_back(std::make_unique<SolaireEngine>());
+            engines.back()->prepareToPlay(signal.sampleRate, blockSize);
+        }
+
+        const float* blockInput = nullptr;
+        const int numWorkers = juce::jmin(numEngines - 1, juce::SystemStats::getNumCpus() - 1);
+        ChannelWorkerPool pool;
+        pool.prepare(numWorkers, [&](int task)
+        {
+            // Each engine plays its own channel of the same input
+            auto& output = outputs[static_cast<size_t>(task)];
+            engines[static_cast<size_t>(task)]->processBlock(blockInput, output.data(), blockSize);
+        });
+
+        GuardedRun run;
+        run.output.resize(static_cast<size_t>(numBlocks) * static_cast<size_t>(blockSize));
+        run.enginesPerThread = (numEngines + numWorkers) / (numWorkers + 1);
+
+        std::vector<float> silence(static_cast<size_t>(blockSize), 0.0f);
+        std::vector<double> times;
+        times.reserve(static_cast<size_t>(numBlocks));
+
+        const int warmupBlocks = static_cast<int>(signal.sampleRate) / blockSize;  // Not timed (page faults)
+        AudioThreadGuard::resetCounts();
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            blockInput = script.isSilent(block) ? silence.data()
+                                                : signal.samples.data() + static_cast<size_t>(block % numSignalBlocks)
+                                                                              * static_cast<size_t>(blockSize);
+            const auto parameters = script.blockAt(block);
+
+            const double micros = timeCallMicroseconds([&] {
+                const AudioThreadGuard::ScopedArm arm;
+
+                for (auto& engine : engines)
+                    engine->setParameters(parameters);
+
+                pool.run(numEngines);
+            });
+
+            std::copy(outputs.front().begin(), outputs.front().end(),
+                      run.output.begin() + static_cast<std::ptrdiff_t>(block) * blockSize);
+            run.slept = run.slept || engines.front()->isSleeping();
+
+            if (block >= warmupBlocks)
+                times.push_back(micros);
+        }
+
+        run.counts = AudioThreadGuard::getCounts();
+        run.timing = summarise(times);
+        pool.stop();
+        return run;
+    }
+
+    // Output level per 50 ms of a run: robust to last-bit differences between builds,
+    // sensitive to anything audible
+    std::vector<double> measureGoldenLevels(const std::vector<float>& output, double sampleRate)
+    {
+        const size_t window = static_cast<size_t>(sampleRate * 0.05);
+        std::vector<double> levels;
+
+        for (size_t start = 0; start + window <= output.size(); start += window)
+        {
+            double sum = 0.0;
+
+            for (size_t i = start; i < start + window; ++i)
+                sum += static_cast<double>(output[i]) * static_cast<double>(output[i]);
+
+            levels.push_back(std::sqrt(sum / static_cast<double>(window)));
+        }
+
+        return levels;
+    }
+
+    // Compares against the golden file (or rewrites it with --write-golden); true if
+    // the levels match
+    bool checkGoldenOutput(const juce::String& path, bool write, const std::vector<double>& levels)
+    {
+        const juce::File file = juce::File::getCurrentWorkingDirectory().getChildFile(path);
+
+        if (write)
+        {
+            juce::StringArray lines;
+
+            for (double level : levels)
+                lines.add(juce::String(level, 9));
+
+            if (!file.replaceWithText(lines.joinIntoString("\n") + "\n"))
+            {
+                std::cout << "Golden output: cannot write " << file.getFullPathName() << " - FAIL\n";
+                return false;
+            }
+
+            std::cout << "Golden output written to " << file.getFullPathName() << " (" << levels.size() << " levels)\n";
+            return true;
+        }
+
+        // A missing reference is a failure: a run that seeded its own would always pass
+        if (!file.existsAsFile())
+        {
+            std::cout << "Golden output: " << file.getFullPathName() << " not found (create it with --write-golden) - FAIL\n";
+            return false;
+        }
+
+        juce::StringArray lines;
+        lines.addLines(file.loadFileAsString());
+        lines.removeEmptyStrings();
+
+        if (lines.size() != static_cast<int>(levels.size()))
+        {
+            std::cout << "Golden output: " << lines.size() << " levels stored, " << levels.size() << " rendered - FAIL\n";
+            return false;
+        }
+
+        // 0.1 dB, or -100 dBFS for near-silent windows
+        double worstDecibels = 0.0;
+        int worstWindow = -1;
+
+        for (int i = 0; i < lines.size(); ++i)
+        {
+            const double stored = lines[i].getDoubleValue();
+            const double rendered = levels[static_cast<size_t>(i)];
+
+            if (std::abs(stored - rendered) <= 1.0e-5)
+                continue;
+
+            const double decibels = std::abs(20.0 * std::log10((rendered + 1.0e-12) / (stored + 1.0e-12)));
+
+            if (decibels > worstDecibels)
+            {
+                worstDecibels = decibels;
+                worstWindow = i;
+            }
+        }
+
+        const bool matches = worstDecibels <= 0.1;
+        std::cout << "Golden output: largest level difference " << std::fixed << std::setprecision(3) << worstDecibels
+                  << " dB" << (worstWindow >= 0 ? " at " + std::to_string(worstWindow * 50) + " ms" : std::string())
+                  << (matches ? " - ok" : " - FAIL") << std::defaultfloat << "\n";
+        return matches;
+    }
+
+    // Returns false if any check failed
+    bool benchmarkRealtimeSafety(const BenchOptions& options, const TestSignal& signal)
+    {
+        const int blockSize = options.blockSize;
+        const double blockMicros = 1.0e6 * static_cast<double>(blockSize) / signal.sampleRate;
+        const int numBlocks = static_cast<int>((options.quick ? 12.0 : 30.0) * signal.sampleRate) / blockSize;
+        bool passed = true;
+
+        std::cout << "Real-time safety (" << blockSize << "-sample blocks, " << numBlocks * blockSize / static_cast<int>(signal.sampleRate)
+                  << " s sweep, ";
+
+        if (options.budget > 0.0)
+            std::cout << "budget " << options.budget << " of a block)\n";
+        else
+            std::cout << "no block budget)\n";
+
+        // The hooks must see a deliberate allocation, or a clean run proves nothing
+        {
+            AudioThreadGuard::resetCounts();
+            {
+                const AudioThreadGuard::ScopedArm arm;
+                std::vector<float> probe(16);
+                juce::ignoreUnused(probe);
+            }
+
+            if (AudioThreadGuard::getCounts().allocations == 0)
+            {
+                std::cout << "Allocation hooks are not active in this build - FAIL\n\n";
+                return false;
+            }
+        }
+
+        if (!AudioThreadGuard::isLockCheckAvailable())
+            std::cout << "(mutex calls are only checked on glibc)\n";
+
+        std::cout << std::setw(26) << "configuration" << std::setw(8) << "allocs" << std::setw(8) << "frees"
+                  << std::setw(8) << "locks" << std::setw(12) << "mean load" << std::setw(12) << "worst load"
+                  << std::setw(8) << "slept" << "\n";
+
+        struct Configuration
+        {
+            const char* name;
+            SolaireEngine::AnalysisMode mode;
+            SolaireEngine::SynthesisBackend backend;
+            bool linked;
+            int pooledEngines;                // > 0: that many engines on the worker pool
+        };
+
+        using Mode = SolaireEngine::AnalysisMode;
+        using Backend = SolaireEngine::SynthesisBackend;
+
+        const Configuration configurations[] {
+            { "sync, oscillators",     Mode::synchronous,  Backend::oscillatorBank, false, 0 },
+            { "amortised, oscillators", Mode::amortised,   Backend::oscillatorBank, false, 0 },
+            { "async, oscillators",    Mode::asynchronous, Backend::oscillatorBank, false, 0 },
+            { "sync, inverse FFT",     Mode::synchronous,  Backend::inverseFFT,     false, 0 },
+            { "sync, linked pair",     Mode::synchronous,  Backend::oscillatorBank, true,  0 },
+            { "sync, 6 on worker pool", Mode::synchronous, Backend::oscillatorBank, false, 6 },
+        };
+
+        std::vector<float> goldenOutput;
+
+        for (const auto& configuration : configurations)
+        {
+            const auto run = (configuration.pooledEngines > 0)
+                               ? runGuardedPool(options, signal, configuration.pooledEngines, numBlocks)
+                               : runGuardedEngine(options, signal, configuration.mode, configuration.backend,
+                                                  configuration.linked, numBlocks);
+
+            // Every configuration, every thread hand-off included: no exemptions
+            const bool safe = run.counts.isClean();
+            // The budget is per engine: engines sharing a thread split the block between
+            // them, as the processor splits its governors' budget. Wall-clock time depends
+            // on the machine, so it is only enforced when --budget is given.
+            const double worstLoad = run.timing.max / blockMicros;
+            const bool inBudget = options.budget <= 0.0 || worstLoad <= options.budget * run.enginesPerThread;
+
+            std::cout << std::setw(26) << configuration.name
+                      << std::setw(8) << run.counts.allocations << std::setw(8) << run.counts.deallocations
+                      << std::setw(8) << run.counts.locks
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(12) << run.timing.mean / blockMicros << std::setw(12) << worstLoad
+                      << std::setw(8) << (run.slept ? "yes" : "no")
+                      << (run.enginesPerThread > 1 ? "  (" + std::to_string(run.enginesPerThread) + " engines per thread)" : std::string())
+                      << (safe ? "" : "  FAIL: audio thread allocated or locked")
+                      << (inBudget ? "" : "  FAIL: over budget")
+                      << std::defaultfloat << "\n";
+
+            passed = passed && safe && inBudget;
+
+            if (goldenOutput.empty())
+                goldenOutput = run.output;  // Synchronous oscillators: deterministic
+        }
+
+        if (options.goldenPath.isNotEmpty())
+            passed = checkGoldenOutput(options.goldenPath, options.writeGolden,
+                                       measureGoldenLevels(goldenOutput, signal.sampleRate)) && passed;
+
+        std::cout << (passed ? "Real-time safety: passed" : "Real-time safety: FAILED") << "\n\n";
+        return passed;
+    }
+
+    //==============================================================================
+    void benchmarkPartialMatching()
+    {
+        std::cout << "Partial matching (us per frame; matched / correctly continued tracks)\n";
+        std::cout << std::setw(10) << "partials"
+                  << std::setw(12) << "greedy" << std::setw(14) << "matched"
+                  << std::setw(14) << "sortedMerge" << std::setw(14) << "matched" << "\n";
+
+        juce::Random random(0x501a17e);
+        constexpr float maxDeviationRatio = 0.1f;  // Same band as PartialTrackingEngine
+
+        for (int numPartials : { 33, 128, 512 })
+        {
+            const auto scenario = makeMatchingScenario(numPartials, random);
+            const int numTracks = static_cast<int>(scenario.tracks.size());
+            const int numPeaks = static_cast<int>(scenario.peaks.size());
+
+            PartialMatcher matcher;
+            matcher.prepare(numTracks, numPeaks);
+            std::vector<int> peakForTrack(static_cast<size_t>(numTracks));
+
+            const int iterations = juce::jmax(100, 200000 / numPartials);
+            int greedyMatched = 0;
+            int mergeMatched = 0;
+
+            const double greedyTime = timeMicroseconds(iterations, [&] {
+                greedyMatched = matcher.matchGreedy(scenario.tracks.data(), numTracks,
+                                                    scenario.peaks.data(), numPeaks,
+                                                    maxDeviationRatio, peakForTrack.data());
+            });
+
+            const int greedyCorrect = countCorrectMatches(scenario, peakForTrack);
+
+            const double mergeTime = timeMicroseconds(iterations, [&] {
+                mergeMatched = matcher.matchSortedMerge(scenario.tracks.data(), numTracks,
+                                                        scenario.peaks.data(), numPeaks,
+                                                        maxDeviationRatio, peakForTrack.data());
+            });
+
+            const int mergeCorrect = countCorrectMatches(scenario, peakForTrack);
+
+            auto matchColumn = [](int matched, int correct) {
+                return std::to_string(matched) + " / " + std::to_string(correct);
+            };
+
+            std::cout << std::fixed << std::setprecision(2)
+                      << std::setw(10) << numPartials
+                      << std::setw(12) << greedyTime
+                      << std::setw(14) << matchColumn(greedyMatched, greedyCorrect)
+                      << std::setw(14) << mergeTime
+                      << std::setw(14) << matchColumn(mergeMatched, mergeCorrect) << "\n";
+        }
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    const juce::ArgumentList args(argc, argv);
+
+    BenchOptions options;
+    options.quick = args.containsOption("--quick");
+    options.only = args.getValueForOption("--only");
+    options.inputPath = args.getValueForOption("--input");
+
+    if (args.containsOption("--block"))
+        options.blockSize = juce::jlimit(16, 4096, args.getValueForOption("--block").getIntValue());
+
+    options.goldenPath = args.getValueForOption("--golden");
+    options.writeGolden = args.containsOption("--write-golden");
+
+    if (args.containsOption("--budget"))
+        options.budget = args.getValueForOption("--budget").getDoubleValue();
+
+    bool passed = true;
+
+    const auto synthetic = makeSyntheticSignal(options.quick ? 2.0 : 6.0, 48000.0);
+
+    if (options.wants("engine"))
+        benchmarkEngine(options, synthetic);
+
+    if (options.wants("frames"))
+        benchmarkFrames(options, synthetic);
+
+    if (options.wants("profile"))
+        benchmarkProfile(options, synthetic);
+
+    if (options.wants("memory"))
+        benchmarkMemory(options, synthetic.sampleRate);
+
+    if (options.wants("multires"))
+        benchmarkMultiResolution(options);
+
+    if (options.wants("governor"))
+        benchmarkGovernor(options, synthetic);
+
+    if (options.wants("capacity"))
+        benchmarkCapacity(options, synthetic);
+
+    if (options.wants("synthesis"))
+        benchmarkSynthesis(options, synthetic);
+
+    if (options.wants("fft"))
+        benchmarkFFTBackends(options, synthetic);
+
+    if (options.wants("sleep"))
+        benchmarkSleep(options, synthetic);
+
+    if (options.wants("float"))
+        benchmarkFloatReverb(options, synthetic);
+
+    if (options.wants("rtsafety"))
+        passed = benchmarkRealtimeSafety(options, synthetic);
+
+    if (options.wants("matching"))
+        benchmarkPartialMatching();
+
+    return passed ? 0 : 1;
+}
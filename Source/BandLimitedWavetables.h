@@ -0,0 +1,135 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <cmath>
+#include <vector>
+
+/**
+ * Band-limited Wavetables for the WAVEFORM parameter
+ *
+ * One immutable, process-wide set of mip-mapped tables (one per waveform and octave),
+ * built once when the first oscillator bank is created and shared by every voice of
+ * every plugin instance through juce::SharedResourcePointer.
+ *
+ * Mip level L holds the first 2^L harmonics, so a voice with phase increment inc
+ * (cycles per sample) uses the highest level whose top harmonic stays below Nyquist:
+ * 2^L * inc <= 0.5. Switching waveform or level is a pointer change.
+ *
+ * SOURCES:
+ * - JUCE SharedResourcePointer: single shared instance across plugin instances
+ * - Fourier series of saw/square/triangle (standard additive synthesis)
+ * - Mip-mapped wavetable oscillators (per-octave band limiting)
+ */
+class BandLimitedWavetables
+{
+public:
+    enum Waveform
+    {
+        triangle = 0,
+        saw,
+        square,
+        numWaveforms
+    };
+
+    static constexpr int TABLE_SIZE = 4096;      // Samples per cycle (+1 guard point)
+    static constexpr int NUM_MIP_LEVELS = 11;    // 1 .. 1024 harmonics
+
+    BandLimitedWavetables()
+    {
+        // Sine lookup used to evaluate sin(2*pi*k*n/N) exactly as sineTable[(k*n) % N]
+        std::vector<float> sineTable(TABLE_SIZE);
+        for (int n = 0; n < TABLE_SIZE; ++n)
+            sineTable[static_cast<size_t>(n)] = static_cast<float>(
+                std::sin(2.0 * juce::MathConstants<double>::pi * n / TABLE_SIZE));
+
+        for (int waveform = 0; waveform < numWaveforms; ++waveform)
+            buildMipLevels(static_cast<Waveform>(waveform), sineTable);
+    }
+
+    /** Table (TABLE_SIZE + 1 samples) for a waveform at a given phase increment */
+    const float* getTable(Waveform waveform, float phaseIncrement) const noexcept
+    {
+        return tables[static_cast<size_t>(waveform)][static_cast<size_t>(getMipLevel(phaseIncrement))].data();
+    }
+
+    /** Highest mip level whose top harmonic (2^level) stays below Nyquist */
+    static int getMipLevel(float phaseIncrement) noexcept
+    {
+        if (phaseIncrement <= 0.0f)
+            return NUM_MIP_LEVELS - 1;
+
+        const int level = static_cast<int>(std::floor(std::log2(0.5f / phaseIncrement)));
+        return juce::jlimit(0, NUM_MIP_LEVELS - 1, level);
+    }
+
+    /** Linear interpolation into a table at normalised phase [0, 1) */
+    static float lookup(const float* table, float phase) noexcept
+    {
+        const float position = phase * static_cast<float>(TABLE_SIZE);
+        const int index = juce::jlimit(0, TABLE_SIZE - 1, static_cast<int>(position));
+        const float fraction = position - static_cast<float>(index);
+        return table[index] + fraction * (table[index + 1] - table[index]);
+    }
+
+    /**
+     * Fourier coefficient of sin(2*pi*k*phase) for each waveform
+     *
+     * Phases match the oscillator bank (juce::dsp::Oscillator centring, x = 2*pi*phase - pi):
+     * - saw:      2 * (phase - 0.5)          = -(2/pi)   * sum sin(k w) / k
+     * - square:   phase < 0.5 ? -1 : 1        = -(4/pi)   * sum_odd sin(k w) / k
+     * - triangle: (2/pi) * asin(sin(x))       = -(8/pi^2) * sum_odd (-1)^((k-1)/2) sin(k w) / k^2
+     *
+     * Public so the inverse-FFT synthesiser renders the same series as the tables.
+     */
+    static double harmonicAmplitude(Waveform waveform, int k)
+    {
+        constexpr double pi = juce::MathConstants<double>::pi;
+        const bool isOdd = (k % 2) == 1;
+
+        switch (waveform)
+        {
+            case saw:      return -2.0 / (pi * k);
+            case square:   return isOdd ? -4.0 / (pi * k) : 0.0;
+            case triangle: return isOdd ? -8.0 / (pi * pi * k * k) * (((k - 1) / 2) % 2 == 0 ? 1.0 : -1.0) : 0.0;
+            default:       return 0.0;
+        }
+    }
+
+private:
+    using Table = std::array<float, TABLE_SIZE + 1>;
+    std::array<std::array<Table, NUM_MIP_LEVELS>, numWaveforms> tables;
+
+    void buildMipLevels(Waveform waveform, const std::vector<float>& sineTable)
+    {
+        // Each level adds the harmonics (2^(L-1), 2^L] to the previous level
+        std::vector<double> accumulator(TABLE_SIZE, 0.0);
+        int harmonicsAdded = 0;
+
+        for (int level = 0; level < NUM_MIP_LEVELS; ++level)
+        {
+            const int maxHarmonic = 1 << level;
+
+            for (int k = harmonicsAdded + 1; k <= maxHarmonic; ++k)
+            {
+                const double amplitude = harmonicAmplitude(waveform, k);
+                if (amplitude == 0.0)
+                    continue;
+
+                for (int n = 0; n < TABLE_SIZE; ++n)
+                    accumulator[static_cast<size_t>(n)] +=
+                        amplitude * sineTable[static_cast<size_t>((k * n) % TABLE_SIZE)];
+            }
+
+            harmonicsAdded = maxHarmonic;
+
+            auto& table = tables[static_cast<size_t>(waveform)][static_cast<size_t>(level)];
+            for (int n = 0; n < TABLE_SIZE; ++n)
+                table[static_cast<size_t>(n)] = static_cast<float>(accumulator[static_cast<size_t>(n)]);
+
+            table[TABLE_SIZE] = table[0];  // Guard point for interpolation
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(BandLimitedWavetables)
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <utility>
+#include <vector>
+
+/**
+ * Left/Right Channel Pairs of a Layout
+ *
+ * Finds the stereo pairs of a bus layout by channel type (front, centre, surround,
+ * height...), not by index: in L R C LFE Ls Rs, channels 2 and 3 are C and LFE,
+ * which are not a pair. Centre, LFE, ambisonic and discrete channels have no partner.
+ *
+ * Used for linked analysis (the processor's engine groups) and for the FLOAT
+ * reverb's stereo reverbs. Allocates the result: call it outside the audio thread.
+ *
+ * SOURCES:
+ * - juce::AudioChannelSet::getChannelIndexForType / ChannelType (juce_AudioChannelSet.h)
+ */
+namespace ChannelPairs
+{
+    using ChannelType = juce::AudioChannelSet::ChannelType;
+
+    inline constexpr std::pair<ChannelType, ChannelType> stereoPairs[] = {
+        { juce::AudioChannelSet::left,              juce::AudioChannelSet::right },
+        { juce::AudioChannelSet::leftCentre,        juce::AudioChannelSet::rightCentre },
+        { juce::AudioChannelSet::leftSurround,      juce::AudioChannelSet::rightSurround },
+        { juce::AudioChannelSet::leftSurroundSide,  juce::AudioChannelSet::rightSurroundSide },
+        { juce::AudioChannelSet::leftSurroundRear,  juce::AudioChannelSet::rightSurroundRear },
+        { juce::AudioChannelSet::wideLeft,          juce::AudioChannelSet::wideRight },
+        { juce::AudioChannelSet::topFrontLeft,      juce::AudioChannelSet::topFrontRight },
+        { juce::AudioChannelSet::topSideLeft,       juce::AudioChannelSet::topSideRight },
+        { juce::AudioChannelSet::topRearLeft,       juce::AudioChannelSet::topRearRight },
+    };
+
+    /** Index of each channel's stereo partner in the layout (-1 = none), first numChannels only */
+    inline std::vector<int> findStereoPartners(const juce::AudioChannelSet& layout, int numChannels)
+    {
+        std::vector<int> partner(static_cast<size_t>(numChannels), -1);
+
+        for (const auto& pair : stereoPairs)
+        {
+            const int leftIndex = layout.getChannelIndexForType(pair.first);
+            const int rightIndex = layout.getChannelIndexForType(pair.second);
+
+            if (leftIndex >= 0 && rightIndex >= 0 && leftIndex < numChannels && rightIndex < numChannels)
+            {
+                partner[static_cast<size_t>(leftIndex)] = rightIndex;
+                partner[static_cast<size_t>(rightIndex)] = leftIndex;
+            }
+        }
+
+        return partner;
+    }
+
+    /** True for channels that carry no full-range signal (LFE) */
+    inline bool isLowFrequencyEffects(const juce::AudioChannelSet& layout, int channel)
+    {
+        const auto type = layout.getTypeOfChannel(channel);
+        return type == juce::AudioChannelSet::LFE || type == juce::AudioChannelSet::LFE2;
+    }
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+/**
+ * Decimated Input History for Long SLICE Windows
+ *
+ * Keeps the newest ringSize samples of the input at 1/2, 1/4, ... 1/32 of the
+ * sample rate, so a window of up to ringSize << numLevels input samples
+ * (2^19 = ~11 s at 48 kHz) can be analysed as a ringSize-point frame of a
+ * decimated signal. The largest FFT stays 2^14 whatever the SLICE length, so
+ * memory stays fixed at numLevels rings and the frame cost never grows.
+ *
+ * Each level is a halfband lowpass + keep-every-second-sample stage fed by the
+ * level above, so the whole cascade costs less than one filter evaluation per
+ * input sample. Content above ~0.4 of a level's rate is attenuated by the
+ * transition band and may alias; callers only pick peaks below usableBandwidth.
+ *
+ * Each ring is stored twice (mirrored), so the newest samples of a level are one
+ * contiguous span whatever the write position, and frames read them in place.
+ *
+ * Real-time safety:
+ * - prepare() allocates (prepareToPlay only)
+ * - push() and getNewest() are allocation-free
+ *
+ * SOURCES:
+ * - Halfband FIR decimation (standard multirate DSP: every second tap is zero)
+ * - Windowed-sinc design with a Blackman window
+ */
+class DecimatedHistory
+{
+public:
+    static constexpr int numLevels = 5;            // Decimation by 2, 4, 8, 16, 32
+    static constexpr int ringSize = 1 << 14;       // Samples kept per level (power of 2)
+    static constexpr float usableBandwidth = 0.4f; // Fraction of a level's rate free of aliasing
+
+    /** Allocate the rings and design the halfband filter (not real-time safe) */
+    void prepare()
+    {
+        designHalfband();
+
+        for (auto& stage : stages)
+            stage.ring.resize(2 * ringSize, 0.0f);  // Mirrored
+
+        reset();
+    }
+
+    void reset()
+    {
+        for (auto& stage : stages)
+        {
+            std::fill(stage.ring.begin(), stage.ring.end(), 0.0f);
+            stage.history.fill(0.0f);
+            stage.writePos = 0;
+            stage.historyPos = 0;
+            stage.outputPending = false;
+        }
+    }
+
+    /** Feed full-rate input (audio thread, allocation-free) */
+    void push(const float* samples, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float value = samples[i];
+
+            // Each level only produces a sample (and feeds the next) every second input
+            for (int level = 0; level < numLevels; ++level)
+            {
+                if (!pushToStage(stages[static_cast<size_t>(level)], value))
+                    break;
+            }
+        }
+    }
+
+    /**
+     * The newest count samples of a level (1 = half rate), oldest first - valid
+     * until the next push()
+     */
+    const float* getNewest(int level, int count) const
+    {
+        jassert(level >= 1 && level <= numLevels && count <= ringSize);
+
+        const auto& stage = stages[static_cast<size_t>(level - 1)];
+        return stage.ring.data() + ((stage.writePos - count) & ringMask);
+    }
+
+    /** Heap bytes held by the rings (the filter state lives in the object itself) */
+    size_t getMemoryBytes() const
+    {
+        size_t bytes = 0;
+
+        for (const auto& stage : stages)
+            bytes += stage.ring.capacity() * sizeof(float);
+
+        return bytes;
+    }
+
+private:
+    static constexpr int ringMask = ringSize - 1;
+    static constexpr int numTaps = 31;                       // Halfband length (4k + 3)
+    static constexpr int centreTap = numTaps / 2;
+    static constexpr int numPairTaps = (centreTap + 1) / 2;  // Non-zero taps on each side
+
+    struct Stage
+    {
+        std::vector<float> ring;                             // Decimated output history, stored twice
+        std::array<float, 2 * numTaps> history{};            // Filter input, stored twice
+        int writePos = 0;
+        int historyPos = 0;
+        bool outputPending = false;                          // Every second input produces output
+    };
+
+    // Returns true (with value replaced by the decimated sample) when the stage produced output
+    bool pushToStage(Stage& stage, float& value)
+    {
+        // Each input is written twice, so the newest numTaps samples are always
+        // contiguous at history[historyPos + 1 ... historyPos + numTaps]
+        stage.history[static_cast<size_t>(stage.historyPos)] = value;
+        stage.history[static_cast<size_t>(stage.historyPos + numTaps)] = value;
+
+        const float* window = stage.history.data() + stage.historyPos + 1;
+        stage.historyPos = (stage.historyPos + 1 == numTaps) ? 0 : stage.historyPos + 1;
+
+        stage.outputPending = !stage.outputPending;
+        if (stage.outputPending)
+            return false;
+
+        // Symmetric halfband: centre tap plus the odd-offset pairs around it
+        float output = 0.5f * window[centreTap];
+
+        for (int k = 0; k < numPairTaps; ++k)
+        {
+            const int offset = 2 * k + 1;
+            output += pairTaps[static_cast<size_t>(k)] * (window[centreTap - offset] + window[centreTap + offset]);
+        }
+
+        stage.ring[static_cast<size_t>(stage.writePos)] = output;
+        stage.ring[static_cast<size_t>(stage.writePos + ringSize)] = output;
+        stage.writePos = (stage.writePos + 1) & ringMask;
+
+        value = output;
+        return true;
+    }
+
+    void designHalfband()
+    {
+        // h[m] = sin(pi m / 2) / (pi m) * blackman, cut-off at a quarter of the input rate
+        std::array<double, numPairTaps> taps{};
+        double pairSum = 0.0;
+
+        for (int k = 0; k < numPairTaps; ++k)
+        {
+            const int offset = 2 * k + 1;
+            const double n = static_cast<double>(centreTap + offset);
+            const double phase = 2.0 * juce::MathConstants<double>::pi * n / (numTaps - 1);
+            const double blackman = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+            const double sinc = std::sin(juce::MathConstants<double>::halfPi * offset)
+                              / (juce::MathConstants<double>::pi * offset);
+
+            taps[static_cast<size_t>(k)] = sinc * blackman;
+            pairSum += 2.0 * taps[static_cast<size_t>(k)];
+        }
+
+        // Unity gain at DC: the centre tap is 0.5, so the pairs must sum to the other half
+        for (size_t k = 0; k < taps.size(); ++k)
+            pairTaps[k] = static_cast<float>(taps[k] * 0.5 / pairSum);
+    }
+
+    std::array<float, numPairTaps> pairTaps{};
+    std::array<Stage, numLevels> stages;
+};
+
+/**
+ * RULE ENFORCEMENT CHECK:
+ *
+ * ✓ Rule #0: No AI attribution? YES - No mentions
+ *
+ * ✓ Rule #1: Using multi-point JUCE examples?
+ *   - YES: Halfband decimation (same structure as juce::dsp::Oversampling's FIR stages)
+ *   - YES: Mirrored rings (same pattern as SolaireEngine's input history and this
+ *     class's own filter history)
+ *
+ * ✓ Rule #2: 95%+ certain?
+ *   - YES: The cascade is a fixed FIR chain - unity DC gain, linear phase
+ *
+ * ✓ Rule #3: Verified against real code?
+ *   - YES: A sine below the usable band reappears at the same frequency in every level
+ *
+ * ✓ Rule #4: Can debug autonomously?
+ *   - YES: Each level's ring can be dumped and inspected as plain audio
+ *
+ * ✓ Rule #5: 95% certain user can test?
+ *   - YES: Turn TIME to the top - low partials keep tracking with a ~6 s window
+ */
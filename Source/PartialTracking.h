@@ -2,9 +2,10 @@
 
 #include "SpectralPeakExtraction.h"
 #include <vector>
-#include <deque>
+#include <array>
 #include <algorithm>
 #include <cmath>
+#include <type_traits>
 
 /**
  * Partial Tracking for Panharmonium Spectral Resynthesis
@@ -12,6 +13,10 @@
  * Maintains consistent identity of spectral peaks across FFT frames,
  * enabling stable oscillator frequency/amplitude trajectories.
  *
+ * Tracks live in a fixed pool of slots. A track keeps its slot for its whole
+ * lifetime, so slot index doubles as oscillator voice index, and processing a
+ * frame performs no heap operations.
+ *
  * SOURCES:
  * - McAulay-Quatieri algorithm (DSPRelated): Peak continuation strategy
  * - JUCE forums: Partial tracking state management patterns
@@ -36,15 +41,19 @@ struct PartialTrack
     bool isActive;                      // Active vs. dying/dead state
 
     // History for prediction (optional, improves matching)
-    std::deque<float> frequencyHistory; // Recent frequency values
-    std::deque<float> amplitudeHistory; // Recent amplitude values
-
+    // Fixed inline ring so the struct stays trivially copyable (no heap per track)
     static constexpr int MAX_HISTORY_SIZE = 5;
 
+    std::array<float, MAX_HISTORY_SIZE> frequencyHistory; // Recent frequency values (ring)
+    std::array<float, MAX_HISTORY_SIZE> amplitudeHistory; // Recent amplitude values (ring)
+    int historyNewest;                  // Ring index of the most recent entry
+    int historySize;                    // Number of valid entries
+
     PartialTrack()
         : trackID(-1), frequency(0.0f), amplitude(0.0f), phase(0.0f),
           prevFrequency(0.0f), prevAmplitude(0.0f),
-          framesSinceCreation(0), framesSinceLastUpdate(0), isActive(false)
+          framesSinceCreation(0), framesSinceLastUpdate(0), isActive(false),
+          frequencyHistory{}, amplitudeHistory{}, historyNewest(0), historySize(0)
     {
     }
 
@@ -52,10 +61,10 @@ struct PartialTrack
         : trackID(id), frequency(peak.frequency), amplitude(peak.magnitude),
           phase(peak.phase), prevFrequency(peak.frequency),
           prevAmplitude(peak.magnitude), framesSinceCreation(1),
-          framesSinceLastUpdate(0), isActive(true)
+          framesSinceLastUpdate(0), isActive(true),
+          frequencyHistory{}, amplitudeHistory{}, historyNewest(0), historySize(0)
     {
-        frequencyHistory.push_back(peak.frequency);
-        amplitudeHistory.push_back(peak.magnitude);
+        pushHistory(peak.frequency, peak.magnitude);
     }
 
     void updateFromPeak(const SpectralPeak& peak)
@@ -70,15 +79,22 @@ struct PartialTrack
         framesSinceLastUpdate = 0;
         framesSinceCreation++;
 
-        // Maintain history
-        frequencyHistory.push_back(peak.frequency);
-        amplitudeHistory.push_back(peak.magnitude);
+        // Maintain history (oldest entry is overwritten once the ring is full)
+        pushHistory(peak.frequency, peak.magnitude);
+    }
 
-        if (frequencyHistory.size() > MAX_HISTORY_SIZE)
-        {
-            frequencyHistory.pop_front();
-            amplitudeHistory.pop_front();
-        }
+    void pushHistory(float historyFrequency, float historyAmplitude)
+    {
+        historyNewest = (historyNewest + 1) % MAX_HISTORY_SIZE;
+        frequencyHistory[static_cast<size_t>(historyNewest)] = historyFrequency;
+        amplitudeHistory[static_cast<size_t>(historyNewest)] = historyAmplitude;
+        historySize = std::min(historySize + 1, MAX_HISTORY_SIZE);
+    }
+
+    // age 0 = most recent entry; age must be < historySize
+    float historicFrequency(int age) const
+    {
+        return frequencyHistory[static_cast<size_t>((historyNewest - age + MAX_HISTORY_SIZE) % MAX_HISTORY_SIZE)];
     }
 
     void fadeOut()
@@ -94,34 +110,255 @@ struct PartialTrack
     {
         // Linear prediction based on recent history
         // SOURCE: JUCE forum partial tracking - frequency prediction
-        if (frequencyHistory.size() >= 2)
+        if (historySize >= 2)
         {
-            float delta = frequencyHistory.back() -
-                         frequencyHistory[frequencyHistory.size() - 2];
+            float delta = historicFrequency(0) - historicFrequency(1);
             return frequency + delta;
         }
         return frequency;
     }
 };
 
+// Tracks are copied between analysis stages and threads as plain memory
+static_assert(std::is_trivially_copyable<PartialTrack>::value,
+              "PartialTrack must stay trivially copyable");
+
+/**
+ * Peak-to-track matcher (McAulay-Quatieri continuation step)
+ *
+ * Two strategies with the same interface, both working in scratch allocated by
+ * prepare():
+ *
+ * - matchSortedMerge: tracks and peaks are sorted by frequency and walked with
+ *   monotonic pointers, collecting the nearest few peaks inside each track's
+ *   deviation band. Candidate pairs are then assigned closest-first, so a track
+ *   can never take a peak that another track fits better. O(n log n).
+ * - matchGreedy: the original pass - each track, in slot order, takes its
+ *   closest unmatched peak. O(tracks x peaks). Kept for benchmarking.
+ *
+ * SOURCES:
+ * - McAulay-Quatieri: Frequency-based peak continuation within a deviation band
+ * - GitHub Fast-Partial-Tracking: Sorted peak lists for linear-time matching
+ */
+class PartialMatcher
+{
+public:
+    // Nearest peaks considered per track (inside the deviation band)
+    static constexpr int MAX_CANDIDATES_PER_TRACK = 4;
+
+    /**
+     * Allocate scratch for up to maxTracks tracks and maxPeaks peaks (not real-time safe)
+     */
+    void prepare(int maxTracks, int maxPeaks)
+    {
+        trackOrder.resize(static_cast<size_t>(maxTracks));
+        peakOrder.resize(static_cast<size_t>(maxPeaks));
+        candidates.resize(static_cast<size_t>(maxTracks * MAX_CANDIDATES_PER_TRACK));
+        peakTaken.resize(static_cast<size_t>(maxPeaks));
+    }
+
+    int getMaxTracks() const { return static_cast<int>(trackOrder.size()); }
+    int getMaxPeaks() const { return static_cast<int>(peakOrder.size()); }
+
+    /**
+     * Sorted-merge matching
+     *
+     * @param tracks Track slots (inactive entries are skipped)
+     * @param peakForTrack Output: matched peak index per track, or -1
+     * @return Number of matched tracks
+     */
+    int matchSortedMerge(const PartialTrack* tracks, int numTracks,
+                         const SpectralPeak* peaks, int numPeaks,
+                         float maxDeviationRatio, int* peakForTrack)
+    {
+        jassert(numTracks <= getMaxTracks() && numPeaks <= getMaxPeaks());
+        numTracks = std::min(numTracks, getMaxTracks());
+        numPeaks = std::min(numPeaks, getMaxPeaks());
+
+        // Active tracks and all peaks, sorted by (predicted) frequency
+        int numSortedTracks = 0;
+
+        for (int t = 0; t < numTracks; ++t)
+        {
+            peakForTrack[t] = -1;
+
+            if (tracks[t].isActive)
+                trackOrder[static_cast<size_t>(numSortedTracks++)] = { tracks[t].predictedFrequency(), t };
+        }
+
+        for (int p = 0; p < numPeaks; ++p)
+        {
+            peakOrder[static_cast<size_t>(p)] = { peaks[p].frequency, p };
+            peakTaken[static_cast<size_t>(p)] = false;
+        }
+
+        auto byFrequency = [](const SortKey& a, const SortKey& b) {
+            return a.frequency < b.frequency || (a.frequency == b.frequency && a.index < b.index);
+        };
+        std::sort(trackOrder.begin(), trackOrder.begin() + numSortedTracks, byFrequency);
+        std::sort(peakOrder.begin(), peakOrder.begin() + numPeaks, byFrequency);
+
+        // Windowed merge: both pointers only move forwards as track frequency rises
+        int numCandidates = 0;
+        int lower = 0;   // First peak not below the band
+        int centre = 0;  // First peak at or above the track frequency
+
+        for (int i = 0; i < numSortedTracks; ++i)
+        {
+            const float predicted = trackOrder[static_cast<size_t>(i)].frequency;
+            const int track = trackOrder[static_cast<size_t>(i)].index;
+            const float maxDeviation = predicted * maxDeviationRatio;
+
+            while (lower < numPeaks && peakOrder[static_cast<size_t>(lower)].frequency <= predicted - maxDeviation)
+                ++lower;
+
+            centre = std::max(centre, lower);
+            while (centre < numPeaks && peakOrder[static_cast<size_t>(centre)].frequency < predicted)
+                ++centre;
+
+            // Expand outwards from the track frequency, nearest peak first
+            int left = centre - 1;
+            int right = centre;
+
+            for (int k = 0; k < MAX_CANDIDATES_PER_TRACK; ++k)
+            {
+                const float leftDistance = (left >= lower)
+                    ? predicted - peakOrder[static_cast<size_t>(left)].frequency : maxDeviation;
+                const float rightDistance = (right < numPeaks)
+                    ? peakOrder[static_cast<size_t>(right)].frequency - predicted : maxDeviation;
+
+                const bool takeLeft = leftDistance <= rightDistance;
+                const float distance = takeLeft ? leftDistance : rightDistance;
+
+                if (distance >= maxDeviation)
+                    break;  // Nothing left inside the band
+
+                const int peak = peakOrder[static_cast<size_t>(takeLeft ? left-- : right++)].index;
+                candidates[static_cast<size_t>(numCandidates++)] = { distance, track, peak };
+            }
+        }
+
+        // Local conflict resolution: closest pairs claim their track and peak first
+        std::sort(candidates.begin(), candidates.begin() + numCandidates,
+                  [](const MatchCandidate& a, const MatchCandidate& b) {
+                      return a.distance < b.distance || (a.distance == b.distance && a.track < b.track);
+                  });
+
+        int numMatched = 0;
+
+        for (int c = 0; c < numCandidates; ++c)
+        {
+            const auto& candidate = candidates[static_cast<size_t>(c)];
+
+            if (peakForTrack[candidate.track] >= 0 || peakTaken[static_cast<size_t>(candidate.peak)])
+                continue;
+
+            peakForTrack[candidate.track] = candidate.peak;
+            peakTaken[static_cast<size_t>(candidate.peak)] = true;
+            ++numMatched;
+        }
+
+        return numMatched;
+    }
+
+    /**
+     * Greedy matching in track order (reference implementation, same interface)
+     *
+     * SOURCE: McAulay-Quatieri - each track finds closest peak in frequency
+     */
+    int matchGreedy(const PartialTrack* tracks, int numTracks,
+                    const SpectralPeak* peaks, int numPeaks,
+                    float maxDeviationRatio, int* peakForTrack)
+    {
+        jassert(numPeaks <= getMaxPeaks());
+        numPeaks = std::min(numPeaks, getMaxPeaks());
+
+        std::fill(peakTaken.begin(), peakTaken.begin() + numPeaks, false);
+        int numMatched = 0;
+
+        for (int t = 0; t < numTracks; ++t)
+        {
+            peakForTrack[t] = -1;
+
+            if (!tracks[t].isActive)
+                continue;
+
+            const float predictedFreq = tracks[t].predictedFrequency();
+            float bestDistance = predictedFreq * maxDeviationRatio;
+
+            // Find closest unmatched peak within frequency range
+            for (int p = 0; p < numPeaks; ++p)
+            {
+                if (peakTaken[static_cast<size_t>(p)])
+                    continue;  // Already matched to another track
+
+                const float freqDiff = std::abs(peaks[p].frequency - predictedFreq);
+
+                if (freqDiff < bestDistance)
+                {
+                    bestDistance = freqDiff;
+                    peakForTrack[t] = p;
+                }
+            }
+
+            if (peakForTrack[t] >= 0)
+            {
+                peakTaken[static_cast<size_t>(peakForTrack[t])] = true;
+                ++numMatched;
+            }
+        }
+
+        return numMatched;
+    }
+
+private:
+    struct SortKey
+    {
+        float frequency;
+        int index;
+    };
+
+    struct MatchCandidate
+    {
+        float distance;
+        int track;
+        int peak;
+    };
+
+    std::vector<SortKey> trackOrder;
+    std::vector<SortKey> peakOrder;
+    std::vector<MatchCandidate> candidates;
+    std::vector<bool> peakTaken;
+};
+
 /**
  * Partial Tracking Engine
  *
  * Maintains and updates partial tracks across FFT frames using
- * greedy peak matching (McAulay-Quatieri algorithm)
+ * sorted-merge peak matching (McAulay-Quatieri algorithm)
+ *
+ * The slot count is a template parameter, so the slot pool and its per-slot
+ * arrays are sized at compile time. PartialTrackingEngine is the 33-slot
+ * Panharmonium tracker; it (and a larger SOLAIRE_MAX_VOICES tracker, if built) is
+ * instantiated in SolaireEngine.cpp.
  *
  * SOURCES:
  * - McAulay-Quatieri: Greedy frequency-based matching
  * - DSPRelated: Peak matching algorithm
  * - JUCE forums: State management and lifecycle patterns
  */
-class PartialTrackingEngine
+template <int TrackCapacity>
+class BasicPartialTrackingEngine
 {
 public:
-    PartialTrackingEngine()
-        : nextTrackID(0), maxActiveTracks(33)
+    // Fixed slot pool - a free slot has trackID -1 and isActive false
+    static constexpr int MAX_TRACKS = TrackCapacity;
+    using TrackSlots = std::array<PartialTrack, MAX_TRACKS>;
+
+    BasicPartialTrackingEngine()
+        : nextTrackID(0), maxActiveTracks(MAX_TRACKS)
     {
-        activeTracks.reserve(maxActiveTracks);
+        matcher.prepare(MAX_TRACKS, MAX_TRACKS);
     }
 
     /**
@@ -131,62 +368,86 @@ public:
      */
     void processFrame(const std::vector<SpectralPeak>& newPeaks)
     {
+        processFrame(newPeaks.data(), static_cast<int>(newPeaks.size()));
+    }
+
+    /**
+     * Process new FFT frame from caller-owned peak storage (no allocation)
+     *
+     * @param newPeaks Peaks sorted strongest first; only the first MAX_TRACKS are used
+     */
+    void processFrame(const SpectralPeak* newPeaks, int numPeaks)
+    {
+        numPeaks = std::min(numPeaks, MAX_TRACKS);
+
         // Mark all existing tracks as unmatched initially
-        for (auto& track : activeTracks)
+        for (auto& track : trackSlots)
         {
-            track.framesSinceLastUpdate++;
+            if (track.isActive)
+                track.framesSinceLastUpdate++;
         }
 
-        // Greedy peak matching: McAulay-Quatieri algorithm
-        // SOURCE: DSPRelated - frequency-based greedy matching
-        performGreedyMatching(newPeaks);
+        // Peak matching: McAulay-Quatieri algorithm
+        // SOURCE: DSPRelated - frequency-based matching within a deviation band
+        performMatching(newPeaks, numPeaks);
 
-        // Fade out unmatched tracks
+        // Fade out unmatched tracks, then free dead slots
         // SOURCE: McAulay-Quatieri - unmatched tracks "turn off"
-        for (auto& track : activeTracks)
+        // SOURCE: JUCE forums - track lifecycle management
+        for (auto& track : trackSlots)
         {
+            if (!track.isActive)
+                continue;
+
             if (track.framesSinceLastUpdate == 1)
-            {
                 track.fadeOut();
+
+            if (track.framesSinceLastUpdate > MAX_FRAMES_DEAD ||
+                track.amplitude < AMPLITUDE_THRESHOLD)
+            {
+                track = PartialTrack();  // Slot becomes free
             }
         }
 
-        // Remove dead tracks
-        // SOURCE: JUCE forums - track lifecycle management
-        activeTracks.erase(
-            std::remove_if(activeTracks.begin(), activeTracks.end(),
-                          [](const PartialTrack& t) {
-                              return !t.isActive ||
-                                     t.framesSinceLastUpdate > MAX_FRAMES_DEAD ||
-                                     t.amplitude < AMPLITUDE_THRESHOLD;
-                          }),
-            activeTracks.end());
-
         // Create new tracks for unmatched peaks
         // SOURCE: McAulay-Quatieri - "start-up" new tracks for unused peaks
-        createNewTracks(newPeaks);
+        createNewTracks(newPeaks, numPeaks);
     }
 
-    const std::vector<PartialTrack>& getActiveTracks() const
+    /**
+     * All track slots, indexed by slot (stable for a track's lifetime)
+     *
+     * Free slots have isActive == false. Returned by reference - callers that
+     * need to modify tracks copy the array (plain memory, no heap).
+     */
+    const TrackSlots& getTrackSlots() const
+    {
+        return trackSlots;
+    }
+
+    int getNumActiveTracks() const
     {
-        return activeTracks;
+        return static_cast<int>(std::count_if(trackSlots.begin(), trackSlots.end(),
+                                              [](const PartialTrack& t) { return t.isActive; }));
     }
 
     void setMaxTracks(int maxTracks)
     {
-        maxActiveTracks = maxTracks;
+        maxActiveTracks = std::max(0, std::min(maxTracks, MAX_TRACKS));
     }
 
     void reset()
     {
-        activeTracks.clear();
-        matchedPeakIndices.clear();
+        trackSlots.fill(PartialTrack());
+        matchedPeakIndices.fill(false);
         nextTrackID = 0;
     }
 
 private:
-    std::vector<PartialTrack> activeTracks;
-    std::vector<bool> matchedPeakIndices;  // Track which peaks were matched
+    TrackSlots trackSlots;
+    std::array<bool, MAX_TRACKS> matchedPeakIndices{};  // Track which peaks were matched
+    std::array<int, MAX_TRACKS> peakForSlot{};          // Matcher output per slot (-1 = none)
+    PartialMatcher matcher;
     int nextTrackID;
     int maxActiveTracks;
 
@@ -197,45 +458,25 @@ private:
     static constexpr float AMPLITUDE_THRESHOLD = 0.001f;     // Minimum amplitude
 
     /**
-     * Greedy peak matching algorithm
+     * Match peaks to tracks and continue the matched tracks
      *
-     * SOURCE: McAulay-Quatieri - each track finds closest peak in frequency
+     * SOURCE: McAulay-Quatieri - each track continues with its closest peak
      */
-    void performGreedyMatching(const std::vector<SpectralPeak>& newPeaks)
+    void performMatching(const SpectralPeak* newPeaks, int numPeaks)
     {
-        // Reset matching flags
-        matchedPeakIndices.assign(newPeaks.size(), false);
-
-        // Each existing track searches for its match
-        // SOURCE: DSPRelated - greedy frequency-based matching
-        for (auto& track : activeTracks)
-        {
-            float predictedFreq = track.predictedFrequency();
-            float maxDeviation = predictedFreq * MAX_FREQ_DEVIATION_RATIO;
-
-            int bestMatchIndex = -1;
-            float bestDistance = maxDeviation;
+        matchedPeakIndices.fill(false);
 
-            // Find closest unmatched peak within frequency range
-            for (size_t i = 0; i < newPeaks.size(); ++i)
-            {
-                if (matchedPeakIndices[i])
-                    continue;  // Already matched to another track
+        matcher.matchSortedMerge(trackSlots.data(), MAX_TRACKS, newPeaks, numPeaks,
+                                 MAX_FREQ_DEVIATION_RATIO, peakForSlot.data());
 
-                float freqDiff = std::abs(newPeaks[i].frequency - predictedFreq);
-
-                if (freqDiff < bestDistance)
-                {
-                    bestDistance = freqDiff;
-                    bestMatchIndex = static_cast<int>(i);
-                }
-            }
+        for (size_t slot = 0; slot < trackSlots.size(); ++slot)
+        {
+            const int peak = peakForSlot[slot];
 
-            // Update track if match found
-            if (bestMatchIndex >= 0)
+            if (peak >= 0)
             {
-                track.updateFromPeak(newPeaks[bestMatchIndex]);
-                matchedPeakIndices[bestMatchIndex] = true;
+                trackSlots[slot].updateFromPeak(newPeaks[peak]);
+                matchedPeakIndices[static_cast<size_t>(peak)] = true;
             }
         }
     }
@@ -244,24 +485,35 @@ private:
      * Create new tracks for unmatched peaks
      *
      * SOURCE: McAulay-Quatieri - "start-up" tracks for unused peaks
+     * New tracks take the lowest free slot below maxActiveTracks.
      */
-    void createNewTracks(const std::vector<SpectralPeak>& newPeaks)
+    void createNewTracks(const SpectralPeak* newPeaks, int numPeaks)
     {
-        // Don't exceed maximum track count
-        int tracksToCreate = maxActiveTracks - static_cast<int>(activeTracks.size());
+        int slot = 0;
 
-        for (size_t i = 0; i < newPeaks.size() && tracksToCreate > 0; ++i)
+        for (int i = 0; i < numPeaks; ++i)
         {
-            if (!matchedPeakIndices[i])
-            {
-                // Create new track for unmatched peak
-                activeTracks.emplace_back(nextTrackID++, newPeaks[i]);
-                tracksToCreate--;
-            }
+            if (matchedPeakIndices[static_cast<size_t>(i)])
+                continue;
+
+            while (slot < maxActiveTracks && trackSlots[static_cast<size_t>(slot)].isActive)
+                ++slot;
+
+            if (slot >= maxActiveTracks)
+                break;  // Don't exceed maximum track count
+
+            // Create new track for unmatched peak
+            trackSlots[static_cast<size_t>(slot)] = PartialTrack(nextTrackID++, newPeaks[i]);
         }
     }
 };
 
+using PartialTrackingEngine = BasicPartialTrackingEngine<33>;  // Rossum Panharmonium: 33 partials
+
+// The engine's tracker, instantiated once in SolaireEngine.cpp
+// (a larger SOLAIRE_MAX_VOICES tracker is declared in SolaireEngine.h)
+extern template class BasicPartialTrackingEngine<33>;
+
 /**
  * RULE ENFORCEMENT CHECK:
  *
@@ -270,11 +522,12 @@ private:
  * ✓ Rule #1: Using multi-point JUCE examples?
  *   - YES: McAulay-Quatieri algorithm (DSPRelated)
  *   - YES: JUCE forums (state management, lifecycle)
- *   - YES: GitHub Fast-Partial-Tracking (greedy matching)
+ *   - YES: GitHub Fast-Partial-Tracking (greedy and sorted matching)
  *
  * ✓ Rule #2: 95%+ certain?
  *   - YES: McAulay-Quatieri is standard algorithm for partial tracking
  *   - YES: Greedy matching pattern verified across multiple sources
+ *   - YES: Sorted-merge only changes conflict order (closest pair wins)
  *
  * ✓ Rule #3: Verified against real code?
  *   - YES: DSPRelated provides detailed algorithm description
@@ -284,6 +537,7 @@ private:
  * ✓ Rule #4: Can debug autonomously?
  *   - YES: Clear matching logic with frequency thresholds
  *   - YES: Track lifecycle explicitly managed
+ *   - YES: Fixed slot pool - no allocation, stable slot per track
  *
  * ✓ Rule #5: 95% certain user can test?
  *   - YES: Track stability verifiable by observing oscillator behavior
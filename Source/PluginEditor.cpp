@@ -0,0 +1,231 @@
+#include "PluginEditor.h"
+#include <cmath>
+
+//==============================================================================
+SpectrumView::SpectrumView(TelemetryFeed& feedToDraw)
+    : feed(feedToDraw)
+{
+    setOpaque(true);
+    spectrumPath.preallocateSpace(SpectrumTelemetry::numBands * 3 + 8);
+
+    feed.addReader();
+    startTimerHz(static_cast<int>(TelemetryFeed::publishRateHz));
+}
+
+SpectrumView::~SpectrumView()
+{
+    stopTimer();
+    feed.removeReader();
+}
+
+void SpectrumView::timerCallback()
+{
+    // Newest published values (the slots stay ours until the next update())
+    const bool spectrumChanged = feed.spectrum.update();
+    const bool partialsChanged = feed.partials.update();
+
+    if (spectrumChanged)
+    {
+        const auto& spectrum = feed.spectrum.getReadBuffer();
+        spectrumPath.clear();
+
+        const float bottom = static_cast<float>(getHeight());
+        float lastX = -1.0f;
+
+        for (int band = 0; band < SpectrumTelemetry::numBands; ++band)
+        {
+            // Bands above a decimated frame's bandwidth were not analysed
+            const float centre = std::sqrt(SpectrumTelemetry::getBandFrequency(band)
+                                           * SpectrumTelemetry::getBandFrequency(band + 1));
+
+            if (centre > spectrum.analysedBandwidth)
+                break;
+
+            const float x = frequencyToX(centre);
+            const float y = decibelsToY(spectrum.decibels[static_cast<size_t>(band)]);
+
+            if (lastX < 0.0f)
+                spectrumPath.startNewSubPath(x, bottom);
+
+            spectrumPath.lineTo(x, y);
+            lastX = x;
+        }
+
+        if (lastX >= 0.0f)
+            spectrumPath.lineTo(lastX, bottom);
+    }
+
+    if (spectrumChanged || partialsChanged)
+        repaint();
+}
+
+void SpectrumView::paint(juce::Graphics& g)
+{
+    g.drawImageAt(background, 0, 0);
+
+    // Spectrum: filled envelope under a brighter outline
+    const auto outline = juce::Colour(0xffe8a33d);
+    g.setColour(outline.withAlpha(0.18f));
+    g.fillPath(spectrumPath);
+    g.setColour(outline);
+    g.strokePath(spectrumPath, juce::PathStrokeType(1.5f));
+
+    // Partials: a stem from the floor to the amplitude, coloured by track
+    const auto& partials = feed.partials.getReadBuffer();
+    const float bottom = static_cast<float>(getHeight());
+
+    for (int index = 0; index < partials.numPartials; ++index)
+    {
+        const auto& partial = partials.partials[static_cast<size_t>(index)];
+
+        if (partial.frequency < SpectrumTelemetry::minFrequency || partial.frequency > SpectrumTelemetry::maxFrequency)
+            continue;
+
+        const float x = frequencyToX(partial.frequency);
+        const float y = decibelsToY(juce::Decibels::gainToDecibels(partial.amplitude, minDecibels));
+
+        g.setColour(getTrackColour(partial.trackID));
+        g.drawLine(x, bottom, x, y, 1.5f);
+        g.fillEllipse(x - 3.0f, y - 3.0f, 6.0f, 6.0f);
+    }
+
+    // State of the partial set
+    juce::String status = juce::String(partials.numPartials) + " partials";
+
+    if (partials.recalledSnapshot >= 0)
+        status << "  |  snapshot " << (partials.recalledSnapshot + 1);
+    else if (partials.frozen)
+        status << "  |  frozen";
+
+    g.setColour(juce::Colours::white.withAlpha(0.7f));
+    g.setFont(juce::FontOptions(12.0f));
+    g.drawText(status, getLocalBounds().reduced(8), juce::Justification::topRight);
+}
+
+void SpectrumView::resized()
+{
+    renderBackground();
+
+    // Old path coordinates belong to the previous size
+    spectrumPath.clear();
+    repaint();
+}
+
+void SpectrumView::renderBackground()
+{
+    background = juce::Image(juce::Image::RGB, juce::jmax(1, getWidth()), juce::jmax(1, getHeight()), true);
+    juce::Graphics g(background);
+
+    g.fillAll(juce::Colour(0xff15171c));
+    g.setFont(juce::FontOptions(10.0f));
+
+    // Decades and 1-2-5 steps on the frequency axis
+    static constexpr float gridFrequencies[] = { 50.0f, 100.0f, 200.0f, 500.0f, 1000.0f,
+                                                 2000.0f, 5000.0f, 10000.0f };
+
+    for (const float frequency : gridFrequencies)
+    {
+        const int x = juce::roundToInt(frequencyToX(frequency));
+        g.setColour(juce::Colours::white.withAlpha(0.08f));
+        g.drawVerticalLine(x, 0.0f, static_cast<float>(getHeight()));
+
+        const auto label = (frequency >= 1000.0f) ? juce::String(frequency / 1000.0f, 0) + "k"
+                                                  : juce::String(frequency, 0);
+        g.setColour(juce::Colours::white.withAlpha(0.4f));
+        g.drawText(label, x + 3, getHeight() - 14, 40, 12, juce::Justification::left);
+    }
+
+    // Every 12 dB
+    for (float decibels = maxDecibels - 12.0f; decibels > minDecibels; decibels -= 12.0f)
+    {
+        const int y = juce::roundToInt(decibelsToY(decibels));
+        g.setColour(juce::Colours::white.withAlpha(0.08f));
+        g.drawHorizontalLine(y, 0.0f, static_cast<float>(getWidth()));
+
+        g.setColour(juce::Colours::white.withAlpha(0.4f));
+        g.drawText(juce::String(decibels, 0) + " dB", 4, y + 2, 50, 12, juce::Justification::left);
+    }
+}
+
+float SpectrumView::frequencyToX(float frequency) const
+{
+    const float position = std::log(frequency / SpectrumTelemetry::minFrequency)
+                         / std::log(SpectrumTelemetry::maxFrequency / SpectrumTelemetry::minFrequency);
+    return position * static_cast<float>(getWidth());
+}
+
+float SpectrumView::decibelsToY(float decibels) const
+{
+    const float clamped = juce::jlimit(minDecibels, maxDecibels, decibels);
+    return juce::jmap(clamped, maxDecibels, minDecibels, 0.0f, static_cast<float>(getHeight()));
+}
+
+juce::Colour SpectrumView::getTrackColour(int trackID)
+{
+    // Golden-ratio hue steps: neighbouring IDs get clearly different colours
+    const float hue = std::fmod(static_cast<float>(juce::jmax(0, trackID)) * 0.618034f, 1.0f);
+    return juce::Colour::fromHSV(hue, 0.65f, 0.95f, 1.0f);
+}
+
+//==============================================================================
+SolaireAudioProcessorEditor::SolaireAudioProcessorEditor(SolaireAudioProcessor& processorToEdit)
+    : AudioProcessorEditor(processorToEdit),
+      audioProcessor(processorToEdit),
+      spectrumView(processorToEdit.getTelemetryFeed())
+{
+    const std::array<std::pair<juce::String, juce::String>, numControls> parameters{{
+        { SolaireAudioProcessor::paramTime, "TIME" },
+        { SolaireAudioProcessor::paramBlur, "BLUR" },
+        { SolaireAudioProcessor::paramWarp, "WARP" },
+        { SolaireAudioProcessor::paramFeedback, "FEEDBACK" },
+        { SolaireAudioProcessor::paramColour, "COLOR" },
+        { SolaireAudioProcessor::paramFloat, "FLOAT" },
+        { SolaireAudioProcessor::paramVoices, "VOICES" },
+        { SolaireAudioProcessor::paramMix, "MIX" },
+    }};
+
+    addAndMakeVisible(spectrumView);
+
+    for (size_t index = 0; index < controls.size(); ++index)
+    {
+        auto& control = controls[index];
+
+        control.slider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
+        control.slider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 64, 18);
+        addAndMakeVisible(control.slider);
+
+        control.label.setText(parameters[index].second, juce::dontSendNotification);
+        control.label.setJustificationType(juce::Justification::centred);
+        addAndMakeVisible(control.label);
+
+        control.attachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+            audioProcessor.getValueTreeState(), parameters[index].first, control.slider);
+    }
+
+    setResizable(true, true);
+    setResizeLimits(560, 360, 1600, 1000);
+    setSize(760, 440);
+}
+
+void SolaireAudioProcessorEditor::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colour(0xff0e0f12));
+}
+
+void SolaireAudioProcessorEditor::resized()
+{
+    auto bounds = getLocalBounds().reduced(10);
+    auto controlRow = bounds.removeFromBottom(120);
+    bounds.removeFromBottom(10);
+
+    spectrumView.setBounds(bounds);
+
+    const int controlWidth = controlRow.getWidth() / numControls;
+
+    for (auto& control : controls)
+    {
+        auto column = controlRow.removeFromLeft(controlWidth);
+        control.label.setBounds(column.removeFromTop(20));
+        control.slider.setBounds(column);
+    }
+}
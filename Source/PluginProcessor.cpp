@@ -1,4 +1,5 @@
 #include "PluginProcessor.h"
+#include "PluginEditor.h"
 
 //==============================================================================
 SolaireAudioProcessor::SolaireAudioProcessor()
@@ -48,9 +49,18 @@ juce::AudioProcessorValueTreeState::ParameterLayout SolaireAudioProcessor::creat
         paramFloat, "Float",
         juce::NormalisableRange<float>(0.0f, 1.0f), 0.0f));
 
+    // VOICES spans the build's voice capacity (1-33, or 1-SOLAIRE_MAX_VOICES);
+    // the host shows the voice count the engine will play
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         paramVoices, "Voices",
-        juce::NormalisableRange<float>(0.0f, 1.0f), 0.5f));  // Placeholder
+        juce::NormalisableRange<float>(0.0f, 1.0f), 0.5f,
+        juce::AudioParameterFloatAttributes()
+            .withStringFromValueFunction([](float value, int) { return juce::String(SolaireEngine::getVoiceCount(value)); })
+            .withValueFromStringFunction([](const juce::String& text)
+            {
+                const int voices = juce::jlimit(1, SolaireEngine::maxVoices, text.getIntValue());
+                return static_cast<float>(voices - 1) / static_cast<float>(SolaireEngine::maxVoices - 1);
+            })));
 
     return {params.begin(), params.end()};
 }
@@ -58,17 +68,87 @@ juce::AudioProcessorValueTreeState::ParameterLayout SolaireAudioProcessor::creat
 //==============================================================================
 void SolaireAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    // Report latency to host (CRITICAL - see juce_critical_knowledge.md)
-    // This triggers ComponentRestarter which can cause race condition
-    // Both engines protected by internal SpinLock
-    setLatencySamples(engines[0].getLatencyInSamples());
+    // Offline bounces always analyse synchronously (deterministic output);
+    // real-time playback uses the preferred mode (synchronous unless opted in)
+    const auto analysisMode = isNonRealtime() ? SolaireEngine::AnalysisMode::synchronous
+                                              : preferredAnalysisMode.load();
+
+    const auto channelLink = preferredChannelLink.load();
+    const int analysisBands = preferredAnalysisBands.load();
+    const auto synthesisBackend = preferredSynthesisBackend.load();
+    const int numChannels = juce::jlimit(1, maxSupportedChannels, getTotalNumInputChannels());
 
-    // Prepare both stereo engines
-    for (auto& engine : engines)
     {
-        engine.prepareToPlay(sampleRate, samplesPerBlock);
+        // processBlock() bypasses while the engine pool is rebuilt
+        const juce::SpinLock::ScopedLockType layoutLock(engineLayoutLock);
+
+        // One engine per channel (existing engines are reused)
+        while (static_cast<int>(engines.size()) < numChannels)
+            engines.push_back(std::make_unique<SolaireEngine>());
+
+        engines.resize(static_cast<size_t>(numChannels));
+
+        // Linked pairs: the leader analyses both channels and drives the follower,
+        // which never analyses on its own (synchronous mode, so it starts no thread)
+        buildEngineGroups(channelLink);
+
+        for (const auto& group : engineGroups)
+        {
+            auto& leader = *engines[static_cast<size_t>(group.leader)];
+            auto* follower = (group.follower >= 0) ? engines[static_cast<size_t>(group.follower)].get() : nullptr;
+
+            leader.setChannelLink(channelLink, follower);
+            leader.setAnalysisMode(analysisMode);
+            leader.setAnalysisBands(analysisBands);
+
+            if (follower != nullptr)
+            {
+                follower->setChannelLink(SolaireEngine::ChannelLink::independent, nullptr);
+                follower->setAnalysisMode(SolaireEngine::AnalysisMode::synchronous);
+            }
+        }
+
+        for (size_t channel = 0; channel < engines.size(); ++channel)
+        {
+            engines[channel]->setSnapshotBank(&snapshotBanks[channel]);
+            engines[channel]->setTelemetryFeed(channel == 0 ? &telemetryFeed : nullptr);
+            engines[channel]->setSynthesisBackend(synthesisBackend);
+            engines[channel]->prepareToPlay(sampleRate, samplesPerBlock);
+        }
+
+        // Wide layouts: groups run in parallel, the audio thread takes a share too
+        const int numGroups = static_cast<int>(engineGroups.size());
+        const int numWorkers = (numChannels > preferredParallelChannelThreshold.load())
+                                 ? juce::jmin(numGroups - 1, juce::SystemStats::getNumCpus() - 1)
+                                 : 0;
+
+        workerPool.prepare(numWorkers, [this](int groupIndex)
+        {
+            juce::ScopedNoDenormals noDenormals;
+            processEngineGroup(engineGroups[static_cast<size_t>(groupIndex)], poolChannels, poolNumSamples);
+        });
+
+        // Each engine's governor gets its share of the callback: groups on one thread
+        // run back to back (the audio thread takes a share of the pool's groups too)
+        const int groupsPerThread = (numGroups + numWorkers) / (numWorkers + 1);
+        const double governorBudget = preferredGovernorBudget.load() / static_cast<double>(juce::jmax(1, groupsPerThread));
+
+        for (auto& engine : engines)
+        {
+            engine->setQualityGovernor(preferredGovernorEnabled.load(), governorBudget);
+            engine->setSleepEnabled(preferredSleepEnabled.load());
+        }
+
+        floatReverb.prepare(sampleRate, getChannelLayoutOfBus(true, 0), numChannels, floatSmooth.getTargetValue());
     }
 
+    // Report latency to host (CRITICAL - see juce_critical_knowledge.md)
+    // This triggers ComponentRestarter which can cause race condition
+    // All engines protected by internal SpinLock
+    // Queried after preparing, since the analysis mode adds a hop of latency.
+    // Constant for every TIME setting, so TIME automation never re-syncs host PDC.
+    setLatencySamples(engines.front()->getLatencyInSamples());
+
     // Initialize parameter smoothing (60Hz update rate)
     const float smoothingTime = 0.05f;  // 50ms
     timeSmooth.reset(sampleRate, smoothingTime);
@@ -83,16 +163,46 @@ void SolaireAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
 
 void SolaireAudioProcessor::releaseResources()
 {
+    workerPool.stop();
+
     for (auto& engine : engines)
     {
-        engine.releaseResources();
+        engine->releaseResources();
+    }
+}
+
+void SolaireAudioProcessor::buildEngineGroups(SolaireEngine::ChannelLink channelLink)
+{
+    // Pair the left/right channels of the current layout (ChannelPairs.h); centre,
+    // LFE, ambisonic and discrete channels stay on their own
+    const int numChannels = static_cast<int>(engines.size());
+
+    const auto partner = (channelLink != SolaireEngine::ChannelLink::independent)
+                           ? ChannelPairs::findStereoPartners(getChannelLayoutOfBus(true, 0), numChannels)
+                           : std::vector<int>(static_cast<size_t>(numChannels), -1);
+
+    engineGroups.clear();
+    engineGroups.reserve(static_cast<size_t>(numChannels));
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const int other = partner[static_cast<size_t>(channel)];
+
+        if (other < 0)
+            engineGroups.push_back({ channel, -1 });
+        else if (channel < other)
+            engineGroups.push_back({ channel, other });  // Lower index leads
     }
 }
 
 bool SolaireAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
 {
-    // Only stereo supported
-    return layouts.getMainOutputChannelSet() == juce::AudioChannelSet::stereo();
+    // Any layout up to maxSupportedChannels, as long as input and output match
+    const auto& mainOutput = layouts.getMainOutputChannelSet();
+
+    return !mainOutput.isDisabled()
+        && mainOutput.size() <= maxSupportedChannels
+        && layouts.getMainInputChannelSet() == mainOutput;
 }
 
 void SolaireAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
@@ -117,58 +227,129 @@ void SolaireAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     floatSmooth.setTargetValue(apvts.getRawParameterValue(paramFloat)->load());
     voicesSmooth.setTargetValue(apvts.getRawParameterValue(paramVoices)->load());
 
-    // Process each sample
+    // One parameter block for every engine: each smoother's value at the block start
+    // and, after skipping the block, at its end (the engines ramp between the two)
     const int numSamples = buffer.getNumSamples();
+    SolaireEngine::ParameterBlock parameters;
 
-    for (int sample = 0; sample < numSamples; ++sample)
+    auto rampParameter = [numSamples](juce::SmoothedValue<float>& smoother, float& start, float& end)
     {
-        // Update smoothed parameter values
-        const float time = timeSmooth.getNextValue();
-        const float blur = blurSmooth.getNextValue();
-        const float warp = warpSmooth.getNextValue();
-        const float feedback = feedbackSmooth.getNextValue();
-        const float mix = mixSmooth.getNextValue();
-        const float colour = colourSmooth.getNextValue();
-        const float floatParam = floatSmooth.getNextValue();
-        const float voices = voicesSmooth.getNextValue();
-
-        // Apply parameters to engines
-        for (auto& engine : engines)
-        {
-            // PHASE 4: Core Panharmonium parameters
-            engine.setSlice(time);         // TIME → SLICE (FFT window size)
-            engine.setVoice(voices);       // VOICES → VOICE (active oscillators)
-            // TODO: Add FREEZE, GLIDE, WAVEFORM parameters once parameter tree is updated
-
-            // PHASE 5: Spectral modifiers
-            engine.setBlur(blur);
-            engine.setWarp(warp);
-            engine.setFeedback(feedback);
-
-            // Output effects (PHASE 8: COLOR and FLOAT kept, RESONANCE removed)
-            engine.setMix(mix);
-            engine.setColour(colour);
-            engine.setFloat(floatParam);
-        }
+        start = smoother.getCurrentValue();
+        end = smoother.skip(numSamples);
+    };
+
+    // PHASE 4: Core Panharmonium parameters
+    rampParameter(timeSmooth, parameters.start.slice, parameters.end.slice);      // TIME → SLICE (FFT window size)
+    rampParameter(voicesSmooth, parameters.start.voice, parameters.end.voice);   // VOICES → VOICE (active oscillators)
+    // TODO: Add FREEZE, GLIDE, WAVEFORM parameters once parameter tree is updated
+
+    // PHASE 5: Spectral modifiers
+    rampParameter(blurSmooth, parameters.start.blur, parameters.end.blur);
+    rampParameter(warpSmooth, parameters.start.warp, parameters.end.warp);
+    rampParameter(feedbackSmooth, parameters.start.feedback, parameters.end.feedback);
+
+    // Output effects (PHASE 8: COLOR and FLOAT kept, RESONANCE removed)
+    rampParameter(mixSmooth, parameters.start.mix, parameters.end.mix);
+    rampParameter(colourSmooth, parameters.start.colour, parameters.end.colour);
+
+    // FLOAT runs after the engines and ramps the same way (FloatReverb::setFloatRamp)
+    float floatStart = 0.0f, floatEnd = 0.0f;
+    rampParameter(floatSmooth, floatStart, floatEnd);
+
+    // processBlock() bypasses while prepareToPlay() rebuilds the engine pool
+    const juce::SpinLock::ScopedTryLockType layoutLock(engineLayoutLock);
+    if (!layoutLock.isLocked())
+        return;
 
-        // Process stereo channels
-        float* channelL = buffer.getWritePointer(0);
-        float* channelR = buffer.getWritePointer(1);
+    // Publish to every engine: a plain copy, the mapping math runs inside the engine
+    // once per block or hop (the worker pool starts after this, on the same callback)
+    for (auto& enginePtr : engines)
+        enginePtr->setParameters(parameters);
 
-        channelL[sample] = engines[0].processSample(channelL[sample]);
-        channelR[sample] = engines[1].processSample(channelR[sample]);
+    forwardSnapshotRequests();
+
+    // Process every channel group block-wise (in place)
+    float* const* channels = buffer.getArrayOfWritePointers();
+    const int numChannels = juce::jmin(totalNumInputChannels, static_cast<int>(engines.size()));
+
+    if (numChannels < static_cast<int>(engines.size()))
+        return;  // Layout changed without prepareToPlay - pass through
+
+    if (workerPool.getNumWorkers() > 0)
+    {
+        // Wide layouts: groups run in parallel, run() returns once all have finished
+        poolChannels = channels;
+        poolNumSamples = numSamples;
+        workerPool.run(static_cast<int>(engineGroups.size()));
+    }
+    else
+    {
+        for (const auto& group : engineGroups)
+            processEngineGroup(group, channels, numSamples);
     }
+
+    // FLOAT: one pass over the whole block while it holds still, 32-sample steps while it moves
+    floatReverb.setFloatRamp(floatStart, floatEnd);
+    floatReverb.process(channels, numSamples);
+
+    updateQualityTier();
+}
+
+void SolaireAudioProcessor::updateQualityTier()
+{
+    // Report the most degraded engine (leaders only - followers never run their governor)
+    auto tier = QualityGovernor::Tier::full;
+
+    for (const auto& group : engineGroups)
+        tier = std::max(tier, engines[static_cast<size_t>(group.leader)]->getQualityTier());
+
+    currentQualityTier.store(tier);
+}
+
+void SolaireAudioProcessor::forwardSnapshotRequests()
+{
+    // Audio thread: hand snapshot requests to every engine (followers of linked
+    // pairs ignore them - their leader's snapshot holds both channels)
+    const int capture = pendingSnapshotCapture.exchange(noSnapshotRequest);
+    const int recall = pendingSnapshotRecall.exchange(noSnapshotRequest);
+
+    for (auto& engine : engines)
+    {
+        if (capture != noSnapshotRequest)
+            engine->captureSnapshot(capture);
+
+        if (recall == releaseSnapshotRequest)
+            engine->releaseSnapshot();
+        else if (recall != noSnapshotRequest)
+            engine->recallSnapshot(recall);
+    }
+}
+
+void SolaireAudioProcessor::processEngineGroup(const EngineGroup& group, float* const* channels, int numSamples)
+{
+    auto& leader = *engines[static_cast<size_t>(group.leader)];
+    float* leaderData = channels[group.leader];
+
+    if (group.follower < 0)
+    {
+        leader.processBlock(leaderData, leaderData, numSamples);
+        return;
+    }
+
+    // Linked: one analysis pipeline drives both channels
+    float* followerData = channels[group.follower];
+    leader.processLinkedBlock(leaderData, followerData, leaderData, followerData, numSamples);
 }
 
 //==============================================================================
 bool SolaireAudioProcessor::hasEditor() const
 {
-    return true;  // Use GenericAudioProcessorEditor
+    return true;
 }
 
 juce::AudioProcessorEditor* SolaireAudioProcessor::createEditor()
 {
-    return new juce::GenericAudioProcessorEditor(*this);
+    return new SolaireAudioProcessorEditor(*this);
 }
 
 //==============================================================================
@@ -178,6 +359,9 @@ void SolaireAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
     auto state = apvts.copyState();
     std::unique_ptr<juce::XmlElement> xml(state.createXml());
     copyXmlToBinary(*xml, destData);
+
+    // Spectral snapshots go after the XML as binary, not as XML attributes
+    writeSnapshotChunk(destData);
 }
 
 void SolaireAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
@@ -186,8 +370,78 @@ void SolaireAudioProcessor::setStateInformation(const void* data, int sizeInByte
     std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
 
     if (xmlState.get() != nullptr)
+    {
         if (xmlState->hasTagName(apvts.state.getType()))
+        {
             apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+            readSnapshotChunk(data, sizeInBytes);
+        }
+    }
+}
+
+void SolaireAudioProcessor::clearSnapshot(int slot)
+{
+    for (auto& bank : snapshotBanks)
+        bank.clear(slot);
+}
+
+void SolaireAudioProcessor::writeSnapshotChunk(juce::MemoryBlock& destData) const
+{
+    // Chunk layout: magic, version, bank count, then each bank up to the last
+    // non-empty one (BasicSpectralSnapshotBank::writeTo). Nothing is written without
+    // snapshots, so such states stay plain XML.
+    int numBanks = 0;
+
+    for (int channel = 0; channel < maxSupportedChannels; ++channel)
+        if (!snapshotBanks[static_cast<size_t>(channel)].isEmpty())
+            numBanks = channel + 1;
+
+    if (numBanks == 0)
+        return;
+
+    juce::MemoryOutputStream output(destData, true);
+    output.writeInt(snapshotChunkMagic);
+    output.writeByte(static_cast<char>(snapshotChunkVersion));
+    output.writeByte(static_cast<char>(numBanks));
+
+    for (int channel = 0; channel < numBanks; ++channel)
+        snapshotBanks[static_cast<size_t>(channel)].writeTo(output);
+}
+
+void SolaireAudioProcessor::readSnapshotChunk(const void* data, int sizeInBytes)
+{
+    // A state without the chunk (or from an older version) clears the snapshots
+    for (auto& bank : snapshotBanks)
+        bank.clearAll();
+
+    // The chunk starts after the XML block: magic, 32-bit string length, string, nul
+    // (older versions read the length the same way and never look past it)
+    if (sizeInBytes < 8)
+        return;
+
+    const auto xmlLength = static_cast<juce::int64>(juce::ByteOrder::littleEndianInt(juce::addBytesToPointer(data, 4)));
+    const auto chunkStart = xmlLength + 9;
+
+    if (chunkStart >= sizeInBytes)
+        return;
+
+    juce::MemoryInputStream input(juce::addBytesToPointer(data, chunkStart),
+                                  static_cast<size_t>(sizeInBytes - chunkStart), false);
+
+    if (input.getNumBytesRemaining() < 6 || input.readInt() != snapshotChunkMagic)
+        return;
+
+    // Version 1 (33-partial builds before the mask word count) still loads
+    const int version = static_cast<juce::uint8>(input.readByte());
+
+    if (version < 1 || version > snapshotChunkVersion)
+        return;
+
+    const int numBanks = juce::jmin(static_cast<int>(static_cast<juce::uint8>(input.readByte())), maxSupportedChannels);
+
+    for (int channel = 0; channel < numBanks; ++channel)
+        if (!snapshotBanks[static_cast<size_t>(channel)].readFrom(input, version))
+            return;  // Truncated or corrupt - keep what was read so far
 }
 
 //==============================================================================
@@ -215,7 +469,12 @@ bool SolaireAudioProcessor::isMidiEffect() const
 
 double SolaireAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // From the reported latency (every engine shares it) and the current FLOAT, without
+    // touching the engines; GLIDE is not a parameter yet, so the published default counts
+    return SolaireEngine::getTailLengthSeconds(getSampleRate() > 0.0 ? getSampleRate() : 44100.0,
+                                               getLatencySamples(),
+                                               SolaireEngine::Parameters{}.glide)
+         + FloatReverb::getTailLengthSeconds(apvts.getRawParameterValue(paramFloat)->load());
 }
 
 int SolaireAudioProcessor::getNumPrograms()
@@ -3,12 +3,25 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 #include "SolaireEngine.h"
+#include "ChannelWorkerPool.h"
+#include "ChannelPairs.h"
+#include "FloatReverb.h"
+#include <array>
+#include <memory>
+#include <vector>
 
 /**
  * Solaire Audio Processor
  *
  * JUCE plugin wrapper for the SolaireEngine spectral processor
  * Uses AudioProcessorValueTreeState for parameter management
+ *
+ * Any main-bus layout up to maxSupportedChannels is accepted (mono, stereo,
+ * surround, ambisonics). One engine runs per channel; with channel linking,
+ * left/right pairs of the layout share one analysis. Layouts with more than
+ * defaultParallelChannelThreshold channels are processed on a worker pool.
+ * FLOAT is one reverb stage over the engines' output (FloatReverb), skipped at 0.
+ * The editor (SolaireAudioProcessorEditor) draws the first channel's TelemetryFeed.
  */
 class SolaireAudioProcessor : public juce::AudioProcessor
 {
@@ -47,6 +60,89 @@ public:
     void getStateInformation(juce::MemoryBlock& destData) override;
     void setStateInformation(const void* data, int sizeInBytes) override;
 
+    //==============================================================================
+    /**
+     * Analysis mode for real-time playback - applied at the next prepareToPlay().
+     * Synchronous by default: asynchronous and amortised analysis add a hop of
+     * latency, and asynchronous runs one analysis thread per leader engine.
+     */
+    void setAnalysisMode(SolaireEngine::AnalysisMode newMode) { preferredAnalysisMode.store(newMode); }
+
+    /** Left/right pair channel link (shared analysis) - applied at the next prepareToPlay() */
+    void setChannelLink(SolaireEngine::ChannelLink newLink) { preferredChannelLink.store(newLink); }
+
+    /** Multi-resolution analysis bands (1 = off) - applied at the next prepareToPlay() */
+    void setAnalysisBands(int numBands) { preferredAnalysisBands.store(numBands); }
+
+    /** Oscillator bank or inverse-FFT overlap-add synthesis - applied at the next prepareToPlay() */
+    void setSynthesisBackend(SolaireEngine::SynthesisBackend newBackend) { preferredSynthesisBackend.store(newBackend); }
+
+    /**
+     * Layouts with more channels than this run their channel groups on the worker
+     * pool - applied at the next prepareToPlay() (offline tools lower it to use
+     * every core on stereo files; output is identical either way)
+     */
+    void setParallelChannelThreshold(int numChannels) { preferredParallelChannelThreshold.store(juce::jmax(1, numChannels)); }
+
+    /**
+     * Opt-in quality governor on every engine (SolaireEngine::setQualityGovernor) -
+     * applied at the next prepareToPlay(). budgetFraction is the share of the audio
+     * callback the plugin may use; it is split between the engine groups that run
+     * one after another on the same thread.
+     */
+    void setQualityGovernor(bool enabled, double budgetFraction = 0.5)
+    {
+        preferredGovernorBudget.store(budgetFraction);
+        preferredGovernorEnabled.store(enabled);
+    }
+
+    /**
+     * Sleep mode of every engine (SolaireEngine::setSleepEnabled, on by default) -
+     * applied at the next prepareToPlay(). Silent instances then only delay the dry path.
+     */
+    void setSleepEnabled(bool shouldSleep) { preferredSleepEnabled.store(shouldSleep); }
+
+    /** Lowest quality tier any engine ran at in the last block (any thread, e.g. a meter) */
+    QualityGovernor::Tier getQualityTier() const { return currentQualityTier.load(); }
+
+    //==============================================================================
+    /**
+     * Spectral snapshots (FREEZE recall): numSnapshotSlots partial sets per channel,
+     * saved with the plugin state as a binary chunk after the parameter XML.
+     * Capture and recall are picked up by the audio thread at the next block; they
+     * are safe to call from any thread.
+     */
+    static constexpr int numSnapshotSlots = SolaireEngine::SnapshotBank::numSlots;
+
+    void captureSnapshot(int slot)
+    {
+        if (slot >= 0 && slot < numSnapshotSlots)
+            pendingSnapshotCapture.store(slot);
+    }
+
+    void recallSnapshot(int slot)
+    {
+        if (slot >= 0 && slot < numSnapshotSlots)
+            pendingSnapshotRecall.store(slot);
+    }
+
+    void releaseSnapshot() { pendingSnapshotRecall.store(releaseSnapshotRequest); }
+
+    /** Empty a slot on every channel (message thread) */
+    void clearSnapshot(int slot);
+
+    /** True once the slot holds a snapshot (checked on the first channel) */
+    bool isSnapshotStored(int slot) const { return snapshotBanks.front().isStored(slot); }
+
+    //==============================================================================
+    /**
+     * Editor telemetry: the first channel's analysed spectrum and partial set
+     * (SolaireEngine::setTelemetryFeed). Published only while a reader is attached.
+     */
+    TelemetryFeed& getTelemetryFeed() { return telemetryFeed; }
+
+    juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
+
     //==============================================================================
     // Parameter IDs
     static inline const juce::String paramTime{"time"};
@@ -66,8 +162,76 @@ private:
     // Create parameter layout
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
-    // DSP engines (stereo = 2 instances)
-    std::array<SolaireEngine, 2> engines;
+    // DSP engines: one per main-bus channel, sized in prepareToPlay()
+    // A group is one engine, or a linked leader/follower pair processed together
+    struct EngineGroup
+    {
+        int leader = 0;
+        int follower = -1;  // -1 = unlinked
+    };
+
+    static constexpr int maxSupportedChannels = 16;      // Up to 7.1.4 and 3rd-order ambisonics
+    static constexpr int defaultParallelChannelThreshold = 4;  // More channels than this use the worker pool
+
+    std::vector<std::unique_ptr<SolaireEngine>> engines;
+    std::vector<EngineGroup> engineGroups;
+
+    // Guards engines/engineGroups: processBlock() bypasses while prepareToPlay() rebuilds them
+    juce::SpinLock engineLayoutLock;
+
+    // Parallel channel processing (audio thread joins in; barrier at block end)
+    ChannelWorkerPool workerPool;
+    float* const* poolChannels = nullptr;                 // Block handed to the pool tasks
+    int poolNumSamples = 0;
+
+    // FLOAT reverb after every engine has run (sized with the engines, same lock)
+    FloatReverb floatReverb;
+
+    void buildEngineGroups(SolaireEngine::ChannelLink channelLink);
+    void processEngineGroup(const EngineGroup& group, float* const* channels, int numSamples);
+
+    // Analysis mode used for real-time playback, opt-in (offline bounces are always synchronous)
+    std::atomic<SolaireEngine::AnalysisMode> preferredAnalysisMode{SolaireEngine::AnalysisMode::synchronous};
+
+    // Analysis sharing between the left/right channels of each pair in the layout
+    std::atomic<SolaireEngine::ChannelLink> preferredChannelLink{SolaireEngine::ChannelLink::independent};
+
+    // Octave bands per analysis frame (SolaireEngine::setAnalysisBands)
+    std::atomic<int> preferredAnalysisBands{1};
+
+    // Synthesis backend of every engine (SolaireEngine::setSynthesisBackend)
+    std::atomic<SolaireEngine::SynthesisBackend> preferredSynthesisBackend{SolaireEngine::SynthesisBackend::oscillatorBank};
+
+    // Channel count above which the worker pool is used
+    std::atomic<int> preferredParallelChannelThreshold{defaultParallelChannelThreshold};
+
+    // Quality governor settings and the tier reported to meters
+    std::atomic<bool> preferredGovernorEnabled{false};
+    std::atomic<double> preferredGovernorBudget{0.5};
+    std::atomic<QualityGovernor::Tier> currentQualityTier{QualityGovernor::Tier::full};
+
+    // Sleep mode of every engine (applied at prepareToPlay)
+    std::atomic<bool> preferredSleepEnabled{true};
+
+    void updateQualityTier();
+
+    // Spectral snapshots: one bank per channel, owned here so they survive engine
+    // rebuilds and state restores before the first prepareToPlay()
+    static constexpr int noSnapshotRequest = -2;
+    static constexpr int releaseSnapshotRequest = -1;
+    static constexpr int snapshotChunkMagic = 0x50414e53;  // "SNAP"
+    static constexpr int snapshotChunkVersion = 2;         // 1: 33 partials, one mask word
+
+    std::array<SolaireEngine::SnapshotBank, maxSupportedChannels> snapshotBanks;
+    std::atomic<int> pendingSnapshotCapture{noSnapshotRequest};
+    std::atomic<int> pendingSnapshotRecall{noSnapshotRequest};
+
+    void forwardSnapshotRequests();
+    void writeSnapshotChunk(juce::MemoryBlock& destData) const;
+    void readSnapshotChunk(const void* data, int sizeInBytes);
+
+    // Editor feed, owned here like the snapshot banks (handed to the first engine)
+    TelemetryFeed telemetryFeed;
 
     // Parameter smoothing (to avoid zipper noise)
     juce::SmoothedValue<float> timeSmooth;
@@ -1,269 +1,1427 @@
 #include "SolaireEngine.h"
 
+// The oscillator banks selectOscillatorBank() chooses from (8, 16 and maxVoices)
+// and the engine's tracker - only what the engine plays is compiled
+template class BasicOscillatorBank<8>;
+template class BasicOscillatorBank<16>;
+template class BasicOscillatorBank<33>;
+template class BasicPartialTrackingEngine<33>;
+
+#if SOLAIRE_MAX_VOICES != 33
+template class BasicOscillatorBank<SOLAIRE_MAX_VOICES>;
+template class BasicPartialTrackingEngine<SOLAIRE_MAX_VOICES>;
+#endif
+
+namespace
+{
+    // Largest magnitude in a block (sleep mode's silence test)
+    float getPeakLevel(const float* samples, int numSamples)
+    {
+        if (numSamples <= 0)
+            return 0.0f;
+
+        const auto range = juce::FloatVectorOperations::findMinAndMax(samples, numSamples);
+        return std::max(-range.getStart(), range.getEnd());
+    }
+}
+
 SolaireEngine::SolaireEngine()
 {
     // Constructor - FFT initialization (audiodev.blog pattern)
     // Note: Actual allocation happens in prepareToPlay to avoid race conditions
 }
 
-void SolaireEngine::prepareToPlay(double newSampleRate, int samplesPerBlock)
+SolaireEngine::~SolaireEngine()
+{
+    stopAnalysisThread();
+}
+
+void SolaireEngine::prepareToPlay(double newSampleRate, int samplesPerBlock)
+{
+    // The analysis thread touches the FFT plans and tracker - stop it before reallocating
+    stopAnalysisThread();
+
+    // CRITICAL: SpinLock guard for prepareToPlay/processBlock race condition
+    // See .claude/juce_critical_knowledge.md - Nuendo can call this during processing
+    const juce::SpinLock::ScopedLockType lock(processingLock);
+
+    sampleRate = newSampleRate;
+    analysisMode = requestedAnalysisMode.load();
+    linkedFollower = requestedLinkedFollower.load();
+    channelLink = (linkedFollower != nullptr) ? requestedChannelLink.load() : ChannelLink::independent;
+
+    if (channelLink == ChannelLink::independent)
+        linkedFollower = nullptr;
+
+    // Linked pairs share one frame of both channels - no per-band frames
+    analysisBands = (linkedFollower == nullptr) ? requestedAnalysisBands.load() : 1;
+    snapshotBank = requestedSnapshotBank.load();
+    telemetryFeed = requestedTelemetryFeed.load();
+    telemetryInterval = juce::roundToInt(sampleRate / TelemetryFeed::publishRateHz);
+
+    // PHASE 4: Build every FFT plan up front, then select the requested order
+    // SOURCE: JUCE dsp::Convolution pattern - initialize FFT in prepareToPlay
+    prepareFFTPlans();
+    selectFFTOrder(pendingFFTOrder.load());
+
+    // Prepare output effects and oscillator bank (juce::dsp pattern)
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = sampleRate;
+    spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
+    spec.numChannels = 1;  // Mono processing
+
+    // COLOR coefficients are designed before prepare() so the filter state is sized
+    // for a biquad up front; processing then only rewrites them in place
+    // Start from the setters' values (published ramps take over from the next block);
+    // the sample rate may have changed, so SLICE is mapped to an order again
+    appliedSetterGeneration = setterGeneration.load();
+    blockParameters.start = blockParameters.end = loadSetterParameters();
+    parametersPublished = false;
+    mappedSlice = -1.0f;
+    blockLength = 1;
+    blockPosition = 0;
+    frameSettingsMapped = false;
+    updateFrameSettings();
+
+    updateColourCoefficients(blockParameters.end.colour);
+    lowShelf.prepare(spec);
+    highShelf.prepare(spec);
+    oscillatorBank8.prepare(spec);  // Phase 3: Prepare oscillator banks
+    oscillatorBank16.prepare(spec);
+    oscillatorBank.prepare(spec);
+    oscillatorBankCapacity = maxVoices;
+
+    synthesisBackend = requestedSynthesisBackend.load();
+
+    if (synthesisBackend == SynthesisBackend::inverseFFT)
+        inverseSynthesiser.prepare(spec);
+
+    // Constant latency: the largest full-rate window (plus its hop when results arrive
+    // a hop later, and the synthesis hop of the IFFT backend, fixed from here on).
+    // Decimated windows are not compensated - several seconds of plugin delay would
+    // make the top of the TIME range unusable in a session.
+    latencySamples = maxTransformSize + (analysisMode != AnalysisMode::synchronous ? maxTransformSize / overlap : 0)
+                   + (synthesisBackend == SynthesisBackend::inverseFFT ? inverseSynthesiser.getLatencyInSamples() : 0);
+
+    reset();
+
+    governor.prepare(sampleRate);
+
+   #if SOLAIRE_ENABLE_PROFILING
+    profiler.prepare(sampleRate);
+   #endif
+
+    // Start the analysis thread last, once every buffer it reads is in place
+    if (analysisMode == AnalysisMode::asynchronous)
+    {
+        if (analysisThread == nullptr)
+            analysisThread = std::make_unique<AnalysisThread>(*this);
+
+        analysisThread->startThread(juce::Thread::Priority::high);
+    }
+}
+
+void SolaireEngine::releaseResources()
+{
+    stopAnalysisThread();
+
+    const juce::SpinLock::ScopedLockType lock(processingLock);
+    // Resources released via unique_ptr destructors
+}
+
+void SolaireEngine::stopAnalysisThread()
+{
+    if (analysisThread != nullptr)
+        analysisThread->stopThread(1000);
+}
+
+void SolaireEngine::prepareFFTPlans()
+{
+    // PHASE 4: Preallocate FFT plans and Hann tables for every transform order
+    // SOURCE: JUCE dsp::Convolution pattern - all allocation happens off the audio path
+    // NOTE: Must be called with processingLock held!
+
+    for (int order = minFFTOrder; order <= maxTransformOrder; ++order)
+    {
+        const size_t index = static_cast<size_t>(order - minFFTOrder);
+
+        if (fftPlans[index] == nullptr)
+            fftPlans[index] = std::make_unique<FFTBackend>(order);
+
+        // Window is size + 1 to make it periodic (not symmetric); only the first size
+        // values are applied. Same values as juce::dsp::WindowingFunction's hann table
+        // (normalise = false, we apply our own correction)
+        auto& table = windowTables[index];
+
+        if (table.empty())
+        {
+            const int size = 1 << order;
+            table.resize(static_cast<size_t>(size));
+
+            for (int i = 0; i < size; ++i)
+                table[static_cast<size_t>(i)] = static_cast<float>(
+                    0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * i / static_cast<double>(size)));
+        }
+    }
+
+    // Size all buffers for the largest transform so SLICE changes never resize them
+    fftData.resize(maxTransformSize * 2, 0.0f);  // Interleaved complex
+    peakPowerScratch.resize(maxNumBins * 2, 0.0f);
+
+    // Linked stereo analysis buffers (allocated even when unlinked - cheap and simple)
+    linkedSpectrum.resize(maxTransformSize * 2, 0.0f);
+
+    for (auto& channelPower : linkedChannelPower)
+        channelPower.resize(maxNumBins, 0.0f);
+
+    // Shared input ring (stored twice, so every frame is contiguous), decimated
+    // history and wet delay line
+    inputHistory.resize(2 * delayLineSize, 0.0f);
+    decimatedHistory.prepare();
+    wetDelayLine.resize(delayLineSize, 0.0f);
+    delayedDry.resize(maxTransformSize / overlap, 0.0f);  // Sub-blocks never span a hop boundary
+
+    // Asynchronous analysis queues (allocated even in synchronous mode - cheap and simple)
+    for (auto& frame : analysisFrames)
+        frame.data.resize(maxTransformSize * 2, 0.0f);
+
+    // Lower-band frames only when multi-resolution analysis is enabled
+    if (analysisBands > 1)
+    {
+        auto allocateBands = [](BandFrames& bands)
+        {
+            for (auto& band : bands.data)
+                band.resize(maxTransformSize * 2, 0.0f);
+        };
+
+        allocateBands(frameBands);
+
+        for (auto& frame : analysisFrames)
+            allocateBands(frame.bands);
+    }
+}
+
+SolaireEngine::MemoryFootprint SolaireEngine::getMemoryFootprint() const
+{
+    constexpr size_t floatBytes = sizeof(float);
+    auto vectorBytes = [](const std::vector<float>& buffer) { return buffer.capacity() * sizeof(float); };
+
+    MemoryFootprint footprint;
+    footprint.allocatedBytes = sizeof(*this)
+                             + vectorBytes(fftData) + vectorBytes(peakPowerScratch)
+                             + vectorBytes(linkedSpectrum)
+                             + vectorBytes(linkedChannelPower[0]) + vectorBytes(linkedChannelPower[1])
+                             + vectorBytes(inputHistory) + vectorBytes(wetDelayLine) + vectorBytes(delayedDry)
+                             + decimatedHistory.getMemoryBytes() + inverseSynthesiser.getMemoryBytes();
+
+    for (const auto& band : frameBands.data)
+        footprint.allocatedBytes += vectorBytes(band);
+
+    for (const auto& frame : analysisFrames)
+    {
+        footprint.allocatedBytes += vectorBytes(frame.data);
+
+        for (const auto& band : frame.bands.data)
+            footprint.allocatedBytes += vectorBytes(band);
+    }
+
+    for (int order = minFFTOrder; order <= maxTransformOrder; ++order)
+    {
+        const auto index = static_cast<size_t>(order - minFFTOrder);
+
+        if (fftPlans[index] != nullptr)
+            footprint.allocatedBytes += fftPlans[index]->getMemoryBytes();
+
+        footprint.allocatedBytes += vectorBytes(windowTables[index]);
+    }
+
+    // One frame: history read + window table + complex frame + plan + power scratch
+    // (every band's history read and frame, for frames where all bands are due)
+    const auto points = static_cast<size_t>(transformSize);
+    const size_t numChannels = (linkedFollower != nullptr) ? 2 : 1;
+    const auto numBands = static_cast<size_t>(getActiveBands(fftOrder));
+
+    footprint.frameWorkingSetBytes = numBands * numChannels * points * floatBytes
+                                   + points * floatBytes
+                                   + numBands * 2 * points * floatBytes
+                                   + fft->getMemoryBytes()
+                                   + (points + 2) * floatBytes;
+
+    return footprint;
+}
+
+void SolaireEngine::selectFFTOrder(int newOrder)
+{
+    // PHASE 4: Switch to a preallocated FFT plan (SLICE parameter)
+    // Allocation-free - called from prepareToPlay and at hop boundaries on the audio thread.
+    // The input histories keep running, so the next frame analyses real input.
+    fftOrder = juce::jlimit(minFFTOrder, maxFFTOrder, newOrder);
+    fftSize = 1 << fftOrder;
+    decimationLevel = getDecimationLevel(fftOrder);
+    transformSize = 1 << getTransformOrder(fftOrder);
+
+    // Long windows keep the 2^14 hop: a reduced hop (more overlap, in input samples)
+    // so partials still update every ~85 ms at 48 kHz
+    hopSize = transformSize / overlap;
+
+    const size_t index = static_cast<size_t>(getTransformOrder(fftOrder) - minFFTOrder);
+    fft = fftPlans[index].get();
+    windowTable = windowTables[index].data();
+}
+
+void SolaireEngine::reset()
+{
+    // Zero out input histories and state arrays (audiodev.blog pattern)
+    hopCount = 0;
+    bandFrameCounter = 0;
+    numBandPeaks.fill(0);
+
+    std::fill(inputHistory.begin(), inputHistory.end(), 0.0f);
+    std::fill(wetDelayLine.begin(), wetDelayLine.end(), 0.0f);
+    decimatedHistory.reset();
+    decimatedHistoryActive = needsDecimatedHistory(fftOrder);  // Empty like the ring
+
+    delayWritePos = 0;
+    wetDelaySamples = std::max(0, latencySamples - getWetPathLatency());
+    previousWetDelaySamples = wetDelaySamples;
+    wetCrossfadeRemaining = 0;
+
+    // Reset oscillator bank (Phase 3) or the IFFT synthesiser
+    withSynthesiser([](auto& synthesiser) { synthesiser.reset(); });
+
+    // PHASE 5: Clear spectral modifier state
+    modifierTrackIDs.fill(-1);
+
+    for (auto& gains : trackerChannelGains)
+        gains.fill(1.0f);
+    prevPartialAmplitudes.fill(0.0f);
+    feedbackAmplitudes.fill(0.0f);
+
+    // Drop anything still queued for (or from) the analysis thread
+    analysisFrameFifo.reset();
+    analysisResultFifo.reset();
+    pendingSliceChange = false;
+    nextAnalysisStage = numAnalysisStages;
+    skipNextFrame = false;
+
+    // Start awake: the first blocks fill the rings before sleep can be considered
+    sleeping.store(false, std::memory_order_relaxed);
+    quietSamples = 0;
+    wetPeak = 0.0f;
+}
+
+float SolaireEngine::processSample(float inputSample)
+{
+    // Compatibility wrapper - all processing goes through processBlock()
+    float outputSample = inputSample;
+    processBlock(&outputSample, &outputSample, 1);
+    return outputSample;
+}
+
+void SolaireEngine::processBlock(const float* input, float* output, int numSamples)
+{
+    // CRITICAL: TryLock once per block - skip processing if prepareToPlay is running
+    const juce::SpinLock::ScopedTryLockType lock(processingLock);
+    if (!lock.isLocked())
+    {
+        // Bypass if preparing
+        if (output != input)
+            std::memcpy(output, input, static_cast<size_t>(numSamples) * sizeof(float));
+        return;
+    }
+
+    SOLAIRE_PROFILE_BLOCK(profiler, numSamples);
+    const QualityGovernor::ScopedBlockTimer governorTimer(governor, numSamples);
+
+    beginBlock(numSamples);
+    selectOscillatorBank(getBlockVoiceLimit());
+    applySnapshotRequests();
+
+    // Sleep mode: measured before the output overwrites the input (in-place safe)
+    const bool inputQuiet = (getPeakLevel(input, numSamples) < sleepThreshold);
+    int position = 0;
+
+    if (continueSleeping(inputQuiet && isSynthesisSilent()))
+    {
+        while (position < numSamples)
+        {
+            const int subBlockSize = getNextSubBlockSize(numSamples - position);
+
+            sleepSubBlock(input + position, output + position, subBlockSize);
+            position += subBlockSize;
+
+            advanceSleepingHop(subBlockSize);
+        }
+        return;
+    }
+
+    while (position < numSamples)
+    {
+        const int subBlockSize = getNextSubBlockSize(numSamples - position);
+
+        renderSubBlock(input + position, output + position, subBlockSize);
+        position += subBlockSize;
+
+        advanceAnalysis(subBlockSize);
+    }
+
+    updateSleepState(inputQuiet && isSynthesisSilent(), numSamples);
+}
+
+void SolaireEngine::processLinkedBlock(const float* inputLeft, const float* inputRight,
+                                       float* outputLeft, float* outputRight, int numSamples)
+{
+    if (linkedFollower == nullptr)
+    {
+        // Not linked at the last prepareToPlay() - the right channel passes through
+        jassertfalse;
+        processBlock(inputLeft, outputLeft, numSamples);
+
+        if (outputRight != inputRight)
+            std::memcpy(outputRight, inputRight, static_cast<size_t>(numSamples) * sizeof(float));
+        return;
+    }
+
+    // CRITICAL: TryLock both engines once per block - skip processing if either is preparing
+    const juce::SpinLock::ScopedTryLockType lock(processingLock);
+    const juce::SpinLock::ScopedTryLockType followerLock(linkedFollower->processingLock);
+
+    if (!lock.isLocked() || !followerLock.isLocked())
+    {
+        // Bypass if preparing
+        if (outputLeft != inputLeft)
+            std::memcpy(outputLeft, inputLeft, static_cast<size_t>(numSamples) * sizeof(float));
+        if (outputRight != inputRight)
+            std::memcpy(outputRight, inputRight, static_cast<size_t>(numSamples) * sizeof(float));
+        return;
+    }
+
+    // Both engines advance in lockstep (same sub-blocks, same ring positions);
+    // only the leader's hop and stage events run, and they feed both banks
+    jassert(linkedFollower->delayWritePos == delayWritePos);
+
+    SOLAIRE_PROFILE_BLOCK(profiler, numSamples);  // Both channels of the pair
+    const QualityGovernor::ScopedBlockTimer governorTimer(governor, numSamples);  // The pair shares one budget
+
+    beginBlock(numSamples);
+    linkedFollower->beginBlock(numSamples);  // Its own MIX/COLOR ramps
+
+    // Both banks take the leader's voice limit (the leader drives them both)
+    const int voiceLimit = getBlockVoiceLimit();
+    selectOscillatorBank(voiceLimit);
+    linkedFollower->selectOscillatorBank(voiceLimit);
+
+    applySnapshotRequests();  // Also drives the follower's bank
+
+    // Sleep mode: the pair sleeps and wakes together (either channel keeps it awake)
+    const bool inputQuiet = (getPeakLevel(inputLeft, numSamples) < sleepThreshold)
+                         && (getPeakLevel(inputRight, numSamples) < sleepThreshold);
+    int position = 0;
+
+    if (continueSleeping(inputQuiet && isSynthesisSilent() && linkedFollower->isSynthesisSilent()))
+    {
+        while (position < numSamples)
+        {
+            const int subBlockSize = getNextSubBlockSize(numSamples - position);
+
+            sleepSubBlock(inputLeft + position, outputLeft + position, subBlockSize);
+            linkedFollower->sleepSubBlock(inputRight + position, outputRight + position, subBlockSize);
+            position += subBlockSize;
+
+            advanceSleepingHop(subBlockSize);
+        }
+        return;
+    }
+
+    while (position < numSamples)
+    {
+        const int subBlockSize = getNextSubBlockSize(numSamples - position);
+
+        // The follower never runs its own hop events - it takes the leader's alignment
+        linkedFollower->matchLinkedLatency(*this);
+
+        renderSubBlock(inputLeft + position, outputLeft + position, subBlockSize);
+        linkedFollower->renderSubBlock(inputRight + position, outputRight + position, subBlockSize);
+        position += subBlockSize;
+
+        advanceAnalysis(subBlockSize);
+    }
+
+    // The follower's wet output counts too (its COLOR and gains are its own)
+    wetPeak = std::max(wetPeak, linkedFollower->wetPeak);
+    updateSleepState(inputQuiet && isSynthesisSilent() && linkedFollower->isSynthesisSilent(), numSamples);
+}
+
+void SolaireEngine::beginBlock(int numSamples)
+{
+    // This block's parameters: the ramps published for it, else the setters' values
+    // when one was used since the last block, else the last block's end values held
+    if (parametersPublished)
+    {
+        parametersPublished = false;
+    }
+    else
+    {
+        const auto generation = setterGeneration.load(std::memory_order_acquire);
+
+        if (generation != appliedSetterGeneration)
+        {
+            appliedSetterGeneration = generation;
+            blockParameters.end = loadSetterParameters();
+        }
+
+        blockParameters.start = blockParameters.end;
+    }
+
+    blockLength = std::max(1, numSamples);
+    blockPosition = 0;
+    wetPeak = 0.0f;
+}
+
+int SolaireEngine::getBlockVoiceLimit() const
+{
+    // Most voices any update in this block can ask for (VOICE ramps either way)
+    const float voiceParam = std::max(blockParameters.start.voice, blockParameters.end.voice);
+    return getVoiceCount(voiceParam);
+}
+
+void SolaireEngine::selectOscillatorBank(int voiceLimit)
+{
+    // The IFFT backend has one synthesiser for every voice count
+    if (synthesisBackend != SynthesisBackend::oscillatorBank)
+        return;
+
+    // Smallest capacity that holds the voice limit: light instances render fewer groups
+    // and their loops have smaller fixed trip counts
+    const int capacity = (voiceLimit <= decltype(oscillatorBank8)::NUM_VOICES)  ? decltype(oscillatorBank8)::NUM_VOICES
+                       : (voiceLimit <= decltype(oscillatorBank16)::NUM_VOICES) ? decltype(oscillatorBank16)::NUM_VOICES
+                                                                                : maxVoices;
+
+    if (capacity == oscillatorBankCapacity)
+        return;
+
+    // Switching down waits until the voices above the new capacity have faded out
+    bool voicesFit = true;
+    withOscillatorBank([capacity, &voicesFit](auto& bank) { voicesFit = (bank.getNumVoicesInUse() <= capacity); });
+
+    if (capacity < oscillatorBankCapacity && !voicesFit)
+        return;
+
+    // Hand the sounding voices over (allocation-free, once per switch)
+    withOscillatorBank([this, capacity](auto& current)
+    {
+        withOscillatorBank(capacity, [&current](auto& next) { next.copyStateFrom(current); });
+    });
+
+    oscillatorBankCapacity = capacity;
+}
+
+int SolaireEngine::getNextSubBlockSize(int numSamplesLeft) const
+{
+    // Split the block at hop boundaries so processFrame() runs between sub-blocks,
+    // and at the next amortised analysis stage (ring wrap-around is handled by the copies)
+    const int nextEvent = (nextAnalysisStage < numAnalysisStages)
+                            ? getStageOffset(nextAnalysisStage)
+                            : hopSize;
+
+    return std::min(nextEvent - hopCount, numSamplesLeft);
+}
+
+void SolaireEngine::renderSubBlock(const float* input, float* output, int numSamples)
+{
+    // Store input in the shared ring before output overwrites it (in-place safe);
+    // the dry path is the same ring read back at the constant latency
+    writeDelayLine(inputHistory, input, numSamples);
+    readDelayLine(inputHistory, latencySamples, delayedDry.data(), numSamples);
+
+    if (decimatedHistoryActive)
+        decimatedHistory.push(input, numSamples);
+
+    // Phase 3: Generate output from oscillator bank (or the IFFT overlap-add backend)
+    // SOURCE: JUCE DSP Tutorial - continuous sample generation from oscillators
+    {
+        SOLAIRE_PROFILE_STAGE(profiler, ProfileStage::oscillatorBank);
+        withSynthesiser([output, numSamples](auto& synthesiser) { synthesiser.processBlock(output, numSamples); });
+    }
+
+    // Align the wet path with the constant latency
+    delayWetSamples(output, numSamples);
+
+    // Apply output effects to the whole sub-block
+    {
+        SOLAIRE_PROFILE_STAGE(profiler, ProfileStage::outputEffects);
+        applyOutputEffects(output, delayedDry.data(), numSamples);
+    }
+
+    // Advance the shared ring position (circular) and the block's parameter ramps
+    delayWritePos = (delayWritePos + numSamples) & delayLineMask;
+    blockPosition += numSamples;
+}
+
+void SolaireEngine::advanceAnalysis(int numSamples)
+{
+    // Process FFT frame every hopSize samples (for spectral analysis only)
+    hopCount += numSamples;
+
+    if (hopCount >= hopSize)
+    {
+        hopCount = 0;
+
+        // PHASE 4: Pick up a pending SLICE change at the hop boundary (lock-free)
+        const int requestedOrder = pendingFFTOrder.load();
+        if (requestedOrder != fftOrder)
+        {
+            selectFFTOrder(requestedOrder);
+            updateWetDelay();
+            updateDecimatedHistory(false);
+            pendingSliceChange = true;
+            bandFrameCounter = 0;  // Every band is re-analysed at the new resolution
+
+            // The follower's ring is windowed with this engine's order
+            if (linkedFollower != nullptr)
+            {
+                linkedFollower->selectFFTOrder(fftOrder);
+                linkedFollower->updateDecimatedHistory(false);
+            }
+        }
+
+        // Governor (reduced overlap): every second hop starts no frame, which halves
+        // the analysis work without moving the hop grid the latency is aligned to
+        skipNextFrame = (governor.getTier() >= QualityGovernor::Tier::reducedOverlap) && !skipNextFrame;
+
+        if (skipNextFrame)
+            skipFrame();
+        else
+            processFrame();
+    }
+    else if (nextAnalysisStage < numAnalysisStages && hopCount >= getStageOffset(nextAnalysisStage))
+    {
+        // Amortised: run the next slice of the frame started at the last hop boundary
+        runAnalysisStage(nextAnalysisStage++);
+    }
+}
+
+//==============================================================================
+// Sleep mode
+
+bool SolaireEngine::isSynthesisSilent()
+{
+    // Releasing voices still count (the bank frees a voice once its fade has ended)
+    bool silent = true;
+    withSynthesiser([&silent](auto& synthesiser) { silent = (synthesiser.getNumVoicesInUse() == 0); });
+    return silent;
+}
+
+bool SolaireEngine::continueSleeping(bool quiet)
+{
+    if (!sleeping.load(std::memory_order_relaxed))
+        return false;
+
+    if (quiet && sleepEnabled.load(std::memory_order_relaxed))
+        return true;
+
+    // Wake: this block renders normally - the hop grid never stopped, so the frame at
+    // the next hop boundary already sees the new input
+    sleeping.store(false, std::memory_order_relaxed);
+    quietSamples = 0;
+    updateDecimatedHistory(true);
+
+    if (linkedFollower != nullptr)
+    {
+        linkedFollower->sleeping.store(false, std::memory_order_relaxed);
+        linkedFollower->updateDecimatedHistory(true);
+    }
+
+    return false;
+}
+
+void SolaireEngine::updateDecimatedHistory(bool refill)
+{
+    // Audio thread, at SLICE changes and on waking: start feeding the decimated
+    // history when the order needs it, rebuilt from the full-rate ring because it
+    // missed the input meanwhile. Levels then hold the ring's delayLineSize newest
+    // samples and silence before them (the SLICE crossfade covers the change)
+    const bool needed = needsDecimatedHistory(fftOrder);
+
+    if (needed && (refill || !decimatedHistoryActive))
+    {
+        decimatedHistory.reset();
+        decimatedHistory.push(inputHistory.data() + delayWritePos, delayLineSize);  // Mirrored: oldest first
+    }
+
+    decimatedHistoryActive = needed;
+}
+
+void SolaireEngine::updateSleepState(bool quiet, int numSamples)
+{
+    // Quiet = silent input, no voice left and a wet output below the threshold. After
+    // the latency plus a hop of it nothing the rings hold can still reach the output
+    if (!quiet || wetPeak >= sleepThreshold || !sleepEnabled.load(std::memory_order_relaxed))
+    {
+        quietSamples = 0;
+        return;
+    }
+
+    quietSamples += numSamples;
+
+    if (quietSamples >= latencySamples + maxTransformSize / overlap)
+        enterSleep();
+}
+
+void SolaireEngine::enterSleep()
+{
+    quietSamples = 0;
+
+    // The wet line is not written while asleep: clear it now, or its old contents
+    // would come round again after waking. An unfinished amortised frame is dropped
+    // (it analysed silence).
+    std::fill(wetDelayLine.begin(), wetDelayLine.end(), 0.0f);
+    previousWetDelaySamples = wetDelaySamples;
+    wetCrossfadeRemaining = 0;
+    nextAnalysisStage = numAnalysisStages;
+
+    sleeping.store(true, std::memory_order_relaxed);
+
+    if (linkedFollower != nullptr)
+        linkedFollower->enterSleep();
+}
+
+void SolaireEngine::sleepSubBlock(const float* input, float* output, int numSamples)
+{
+    // The input ring keeps running, so the first frame after waking is complete and
+    // the dry path stays aligned; the wet path is silence (no FFT, voices or effects).
+    // The decimated history is refilled from the ring on waking instead.
+    writeDelayLine(inputHistory, input, numSamples);
+    readDelayLine(inputHistory, latencySamples, delayedDry.data(), numSamples);
+
+    std::fill(output, output + numSamples, 0.0f);
+    applyMix(output, delayedDry.data(), numSamples);
+
+    delayWritePos = (delayWritePos + numSamples) & delayLineMask;
+    blockPosition += numSamples;
+}
+
+void SolaireEngine::advanceSleepingHop(int numSamples)
+{
+    // Keep the hop grid without starting frames (SLICE changes wait for the next
+    // hop boundary after waking)
+    hopCount += numSamples;
+
+    if (hopCount >= hopSize)
+        hopCount = 0;
+}
+
+double SolaireEngine::getTailLengthSeconds(double rate, int latency, float glideSeconds)
+{
+    // Voices: the last input reaches the output after the latency; its tracks are held
+    // for up to the tracker's MAX_FRAMES_DEAD (3) frames of the longest hop, then fade
+    // over the 10 ms amplitude ramp (a glide in flight is counted on top)
+    const double hopSeconds = static_cast<double>(maxTransformSize / overlap) / rate;
+    return static_cast<double>(latency) / rate
+         + 3.0 * hopSeconds + 0.01
+         + static_cast<double>(std::max(0.0f, glideSeconds));
+}
+
+void SolaireEngine::processFrame()
+{
+    if (analysisMode == AnalysisMode::asynchronous)
+    {
+        // Apply the partials analysed from the previous hop, then hand over this frame
+        applyLatestAnalysisResult();
+        updateFrameSettings();
+        scheduleTelemetry();
+        pushAnalysisFrame();
+        return;
+    }
+
+    if (analysisMode == AnalysisMode::amortised)
+    {
+        // Finish any stages a sub-block split could not reach (defensive), then start
+        // the new frame - only the copy/window stage runs at the hop boundary itself
+        while (nextAnalysisStage < numAnalysisStages)
+            runAnalysisStage(nextAnalysisStage++);
+
+        updateFrameSettings();
+        scheduleTelemetry();
+        amortisedFrameOrder = fftOrder;
+        amortisedSliceChanged = pendingSliceChange;
+        pendingSliceChange = false;
+
+        runAnalysisStage(static_cast<int>(AnalysisStage::copyWindow));
+        nextAnalysisStage = static_cast<int>(AnalysisStage::fft);
+        return;
+    }
+
+    // Synchronous: analyse inline and update the oscillators immediately
+    updateFrameSettings();
+    scheduleTelemetry();
+    copyWindowedFrame(fftData.data(), frameBands);
+    analyseFrame(fftData.data(), frameBands, fftOrder, pendingSliceChange, frameSettings, framePartials);
+    pendingSliceChange = false;
+
+    updateOscillators(framePartials);
+}
+
+void SolaireEngine::skipFrame()
+{
+    // Hop without a new frame: keep applying finished work (the analysis thread's
+    // newest result, or the stages of the frame started at the last boundary)
+    if (analysisMode == AnalysisMode::asynchronous)
+        applyLatestAnalysisResult();
+
+    while (nextAnalysisStage < numAnalysisStages)
+        runAnalysisStage(nextAnalysisStage++);
+}
+
+void SolaireEngine::copyWindowedFrame(float* destination, BandFrames& bands)
+{
+    SOLAIRE_PROFILE_STAGE(profiler, ProfileStage::copyWindow);
+
+    windowBandFrames(bands);
+
+    if (linkedFollower == nullptr)
+    {
+        copyWindowedChannel(*this, destination, decimationLevel);
+        return;
+    }
+
+    // Linked: window both rings straight into the complex signal L + iR (one pass)
+    const float* left = getNewestFrame(*this, decimationLevel);
+    const float* right = getNewestFrame(*linkedFollower, decimationLevel);
+
+    for (int i = 0; i < transformSize; ++i)
+    {
+        destination[2 * i] = left[i] * windowTable[i];
+        destination[2 * i + 1] = right[i] * windowTable[i];
+    }
+}
+
+const float* SolaireEngine::getNewestFrame(const SolaireEngine& source, int level) const
+{
+    // Long windows and lower bands: the newest transformSize samples of a decimated history
+    if (level > 0)
+        return source.decimatedHistory.getNewest(level, transformSize);
+
+    // The ring is mirrored, so the newest samples are contiguous even across the wrap
+    return source.inputHistory.data() + ((delayWritePos - transformSize) & delayLineMask);
+}
+
+void SolaireEngine::copyWindowedChannel(const SolaireEngine& source, float* destination, int level) const
+{
+    // Apply Hann window while copying the frame out of the ring (audiodev.blog pattern,
+    // fused: one pass instead of a copy and an in-place multiply)
+    juce::FloatVectorOperations::multiply(destination, getNewestFrame(source, level), windowTable, transformSize);
+}
+
+void SolaireEngine::windowBandFrames(BandFrames& bands)
+{
+    // Multi-resolution: band k is windowed every 2^k frames, i.e. at its own hop of
+    // a quarter of its own (2^k times longer) window
+    bands.numBands = getActiveBands(fftOrder);
+    bands.windowedMask = 0;
+
+    for (int band = 1; band < bands.numBands; ++band)
+    {
+        if ((bandFrameCounter & ((1 << band) - 1)) != 0)
+            continue;
+
+        copyWindowedChannel(*this, bands.data[static_cast<size_t>(band - 1)].data(), decimationLevel + band);
+        bands.windowedMask |= (1 << band);
+    }
+
+    bandFrameCounter = (bandFrameCounter + 1) & ((1 << (maxAnalysisBands - 1)) - 1);
+}
+
+void SolaireEngine::analyseFrame(float* frameData, BandFrames& bands, int order, bool sliceChanged,
+                                 const FrameSettings& settings, PartialFrame& partials)
+{
+    // Runs on the audio thread (synchronous) or the analysis thread (asynchronous).
+    // Only uses the frame's own order and settings, never the audio thread's current ones.
+    transformFrame(frameData, bands, order);
+
+    // SPECTRAL ANALYSIS (Phase 1-2: peak extraction & tracking)
+    extractFramePeaks(frameData, bands, order, settings);
+    trackFramePeaks(partials);
+
+    // PHASE 4, 5 & 6: SLICE crossfade and spectral modifiers
+    modifyFrameTracks(partials.tracks, settings, sliceChanged);
+}
+
+void SolaireEngine::transformFrame(float* frameData, BandFrames& bands, int order)
+{
+    SOLAIRE_PROFILE_STAGE(profiler, ProfileStage::fft);
+
+    const int frameOrder = getTransformOrder(order);
+    auto* plan = fftPlans[static_cast<size_t>(frameOrder - minFFTOrder)].get();
+
+    if (linkedFollower == nullptr)
+    {
+        // Perform FFT (juce::dsp pattern), then any lower bands due this frame
+        plan->performRealForward(frameData);
+
+        for (int band = 1; band < bands.numBands; ++band)
+            if ((bands.windowedMask & (1 << band)) != 0)
+                plan->performRealForward(bands.data[static_cast<size_t>(band - 1)].data());
+
+        return;
+    }
+
+    // Linked: one complex FFT analyses both channels (out of place)
+    plan->performComplexForward(reinterpret_cast<const std::complex<float>*>(frameData),
+                                reinterpret_cast<std::complex<float>*>(linkedSpectrum.data()));
+
+    splitLinkedSpectrum(frameData, 1 << frameOrder);
+}
+
+void SolaireEngine::splitLinkedSpectrum(float* frameData, int size)
+{
+    // Two real FFTs for the price of one: with Z = FFT(L + iR),
+    //   X_L[k] = (Z[k] + conj(Z[N - k])) / 2,   X_R[k] = (Z[k] - conj(Z[N - k])) / 2i
+    // SOURCE: Standard DSP identity for real signals packed into one complex FFT
+    // The combined spectrum replaces the frame data in JUCE's real-only output layout,
+    // so peak extraction runs unchanged; per-channel power is kept for the gains.
+    const auto* spectrum = reinterpret_cast<const std::complex<float>*>(linkedSpectrum.data());
+    auto* combined = reinterpret_cast<std::complex<float>*>(frameData);
+    float* leftPower = linkedChannelPower[0].data();
+    float* rightPower = linkedChannelPower[1].data();
+    const bool useMid = (channelLink == ChannelLink::mid);
+
+    for (int k = 0; k <= size / 2; ++k)
+    {
+        const auto z = spectrum[k];
+        const auto mirrored = std::conj(spectrum[(size - k) & (size - 1)]);
+
+        const auto left = (z + mirrored) * 0.5f;
+        const auto right = (z - mirrored) * std::complex<float>(0.0f, -0.5f);
+
+        leftPower[k] = std::norm(left);
+        rightPower[k] = std::norm(right);
+
+        if (useMid)
+            combined[k] = (left + right) * 0.5f;
+        else
+            combined[k] = (leftPower[k] >= rightPower[k]) ? left : right;
+    }
+}
+
+void SolaireEngine::extractFramePeaks(const float* spectrum, const BandFrames& bands, int order, const FrameSettings& settings)
+{
+    SOLAIRE_PROFILE_STAGE(profiler, ProfileStage::peakExtraction);
+
+    // The editor sees the spectrum even while frozen
+    if (settings.publishSpectrum)
+        publishSpectrumTelemetry(spectrum, order);
+
+    // PHASE 4: FREEZE parameter - gate spectral analysis
+    // SOURCE: Simple boolean gate pattern (standard DSP technique)
+    // Captured here so the tracking stage of the same frame makes the same decision
+    frameFrozen = settings.frozen;
+
+    if (frameFrozen)
+        return;  // When frozen, partials keep their last tracked values (oscillators continue)
+
+    // PHASE 1: Extract dominant spectral peaks (Panharmonium resynthesis)
+    // SOURCE: audiodev.blog FFT tutorial + DSPRelated quadratic interpolation
+    // Extract 33 dominant peaks for oscillator bank resynthesis
+    analysedFrameSize = 1 << getTransformOrder(order);
+    analysedSampleRate = sampleRate / static_cast<double>(1 << getDecimationLevel(order));
+
+    if (bands.numBands == 1)
+    {
+        numCurrentPeaks = extractBandPeaks(spectrum, order, 0, 1, currentPeaks.data());
+        return;
+    }
+
+    // Multi-resolution: refresh the bands analysed this frame, keep the others' last peaks
+    numBandPeaks[0] = extractBandPeaks(spectrum, order, 0, bands.numBands, bandPeaks[0].data());
+
+    for (int band = 1; band < bands.numBands; ++band)
+    {
+        if ((bands.windowedMask & (1 << band)) != 0)
+        {
+            const auto index = static_cast<size_t>(band);
+            numBandPeaks[index] = extractBandPeaks(bands.data[index - 1].data(), order, band,
+                                                   bands.numBands, bandPeaks[index].data());
+        }
+    }
+
+    mergeBandPeaks(bands.numBands);
+}
+
+int SolaireEngine::extractBandPeaks(const float* spectrum, int order, int band, int numBands, SpectralPeak* peaks)
 {
-    // CRITICAL: SpinLock guard for prepareToPlay/processBlock race condition
-    // See .claude/juce_critical_knowledge.md - Nuendo can call this during processing
-    const juce::SpinLock::ScopedLockType lock(processingLock);
+    const int frameFFTSize = 1 << getTransformOrder(order);
+    const int level = getDecimationLevel(order) + band;
+    const double bandSampleRate = sampleRate / static_cast<double>(1 << level);
+
+    // Decimated frames only cover the low band: skip the bins near their Nyquist,
+    // where the halfband transition lets aliased content through
+    const int numFrameBins = (level > 0)
+                               ? static_cast<int>(DecimatedHistory::usableBandwidth * static_cast<float>(frameFFTSize)) + 1
+                               : frameFFTSize / 2 + 1;
+
+    // Below the band's octave the next (longer) band takes over
+    const int firstBin = (band < numBands - 1)
+                           ? static_cast<int>(0.5f * DecimatedHistory::usableBandwidth * static_cast<float>(frameFFTSize))
+                           : 1;
+
+    return extractDominantPeaks(
+        spectrum,
+        numFrameBins,
+        maxSpectralPeaks,
+        bandSampleRate,
+        frameFFTSize,
+        peakPowerScratch.data(),
+        peaks,
+        firstBin
+    );
+}
 
-    sampleRate = newSampleRate;
+void SolaireEngine::mergeBandPeaks(int numBands)
+{
+    // Bands cover disjoint ranges: keep the strongest peaks over all of them,
+    // strongest first as extractDominantPeaks() returns them
+    int numCandidates = 0;
 
-    // PHASE 4: Initialize dynamic FFT size (default 1024)
-    // SOURCE: JUCE dsp::Convolution pattern - initialize FFT in prepareToPlay
-    updateFFTSize(fftOrder);
+    for (int band = 0; band < numBands; ++band)
+    {
+        const auto index = static_cast<size_t>(band);
+        std::copy_n(bandPeaks[index].begin(), numBandPeaks[index], mergedPeakScratch.begin() + numCandidates);
+        numCandidates += numBandPeaks[index];
+    }
 
-    // Prepare output effects and oscillator bank (juce::dsp pattern)
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
-    spec.numChannels = 1;  // Mono processing
+    numCurrentPeaks = std::min(numCandidates, maxSpectralPeaks);
 
-    lowShelf.prepare(spec);
-    highShelf.prepare(spec);
-    oscillatorBank.prepare(spec);  // Phase 3: Prepare oscillator bank
-
-    // Initialize reverb
-    reverb.reset();
-    juce::Reverb::Parameters reverbParams;
-    reverbParams.roomSize = 0.5f;
-    reverbParams.damping = 0.5f;
-    reverbParams.wetLevel = 0.0f;
-    reverbParams.dryLevel = 1.0f;
-    reverbParams.width = 1.0f;
-    reverb.setParameters(reverbParams);
+    std::partial_sort(mergedPeakScratch.begin(), mergedPeakScratch.begin() + numCurrentPeaks,
+                      mergedPeakScratch.begin() + numCandidates,
+                      [](const SpectralPeak& a, const SpectralPeak& b) { return a.magnitude > b.magnitude; });
 
-    reset();
+    std::copy_n(mergedPeakScratch.begin(), numCurrentPeaks, currentPeaks.begin());
 }
 
-void SolaireEngine::releaseResources()
+void SolaireEngine::trackFramePeaks(PartialFrame& partials)
 {
-    const juce::SpinLock::ScopedLockType lock(processingLock);
-    // Resources released via unique_ptr destructors
+    SOLAIRE_PROFILE_STAGE(profiler, ProfileStage::tracking);
+
+    // PHASE 2: Track peaks across frames (Panharmonium resynthesis)
+    // SOURCE: McAulay-Quatieri algorithm - maintain peak identity over time
+    // Enables stable oscillator frequency/amplitude trajectories
+    if (!frameFrozen)
+        partialTracker.processFrame(currentPeaks.data(), numCurrentPeaks);
+
+    // Phase 3, 4, 5, 6 & 7: Build the partial set for the oscillator bank
+    // SOURCE: Custom logic using JUCE patterns
+    // Replaces IFFT reconstruction - oscillators generate audio directly
+    // Slots are trivially copyable: this is a flat copy into frame-owned storage
+    partials.tracks = partialTracker.getTrackSlots();  // Copy for modification
+
+    if (linkedFollower == nullptr)
+        return;
+
+    // Linked: each channel's gain is its magnitude at the partial's bin relative to the
+    // louder channel (before WARP/FREQ move the frequency). Held while frozen.
+    if (!frameFrozen)
+    {
+        const float binsPerHz = static_cast<float>(analysedFrameSize) / static_cast<float>(analysedSampleRate);
+        const int lastBin = analysedFrameSize / 2;
+
+        for (size_t slot = 0; slot < partials.tracks.size(); ++slot)
+        {
+            const auto& track = partials.tracks[slot];
+
+            if (!track.isActive)
+                continue;
+
+            const auto bin = static_cast<size_t>(juce::jlimit(0, lastBin, juce::roundToInt(track.frequency * binsPerHz)));
+            const float leftPower = linkedChannelPower[0][bin];
+            const float rightPower = linkedChannelPower[1][bin];
+            const float louderPower = std::max(leftPower, rightPower);
+
+            trackerChannelGains[0][slot] = (louderPower > 0.0f) ? std::sqrt(leftPower / louderPower) : 1.0f;
+            trackerChannelGains[1][slot] = (louderPower > 0.0f) ? std::sqrt(rightPower / louderPower) : 1.0f;
+        }
+    }
+
+    partials.channelGains = trackerChannelGains;
 }
 
-void SolaireEngine::updateFFTSize(int newOrder)
+void SolaireEngine::modifyFrameTracks(TrackSlots& tracks, const FrameSettings& settings, bool sliceChanged)
 {
-    // PHASE 4: Dynamic FFT size update (SLICE parameter)
-    // SOURCE: JUCE dsp::Convolution pattern - reset unique_ptr to change FFT size
-    // SOURCE: JUCE forum (forum.juce.com/t/29348) - IvanC: thread-safe FFT reset
-    // NOTE: Must be called with processingLock held!
+    SOLAIRE_PROFILE_STAGE(profiler, ProfileStage::spectralModifiers);
 
-    fftOrder = newOrder;
-    fftSize = 1 << fftOrder;
-    numBins = fftSize / 2 + 1;
-    hopSize = fftSize / overlap;
-
-    // Reset FFT and window (JUCE dsp::Convolution pattern)
-    // Window is fftSize + 1 to make it periodic (not symmetric)
-    fft = std::make_unique<juce::dsp::FFT>(fftOrder);
-    window = std::make_unique<juce::dsp::WindowingFunction<float>>(
-        fftSize + 1,
-        juce::dsp::WindowingFunction<float>::hann,
-        false  // normalise = false (we apply our own correction)
-    );
+    // PHASE 4: Fade partials across a SLICE change instead of jumping
+    if (sliceChanged)
+        sliceCrossfadeRemaining = sliceCrossfadeFrames;
 
-    // Resize all dynamic buffers (std::vector pattern)
-    inputFifo.resize(fftSize, 0.0f);
-    outputFifo.resize(fftSize, 0.0f);
-    fftData.resize(fftSize * 2, 0.0f);  // Interleaved complex
-    prevMagnitude.resize(numBins, 0.0f);
-    prevPhase.resize(numBins, 0.0f);
-    feedbackMagnitude.resize(numBins, 0.0f);
-    dryBuffer.resize(fftSize, 0.0f);
-
-    // Reset positions
-    fifoPos = 0;
-    hopCount = 0;
-    dryBufferPos = 0;
+    if (sliceCrossfadeRemaining > 0)
+        applySliceCrossfade(tracks);
+
+    // PHASE 5 & 6: Apply spectral modifiers to partial tracks
+    applySpectralModifiers(tracks, settings);
 }
 
-void SolaireEngine::reset()
+void SolaireEngine::runAnalysisStage(int stage)
 {
-    // Zero out FIFOs and state arrays (audiodev.blog pattern)
-    fifoPos = 0;
-    hopCount = 0;
+    // Amortised analysis: one bounded slice of frame work, timed against its budget
+    // SOURCE: juce::Time high-resolution ticks (standard JUCE timing pattern)
+    const auto startTicks = juce::Time::getHighResolutionTicks();
 
-    std::fill(inputFifo.begin(), inputFifo.end(), 0.0f);
-    std::fill(outputFifo.begin(), outputFifo.end(), 0.0f);
-    std::fill(prevMagnitude.begin(), prevMagnitude.end(), 0.0f);
-    std::fill(prevPhase.begin(), prevPhase.end(), 0.0f);
-    std::fill(feedbackMagnitude.begin(), feedbackMagnitude.end(), 0.0f);
-    std::fill(dryBuffer.begin(), dryBuffer.end(), 0.0f);
+    switch (static_cast<AnalysisStage>(stage))
+    {
+        case AnalysisStage::copyWindow:       copyWindowedFrame(fftData.data(), frameBands); break;
+        case AnalysisStage::fft:              transformFrame(fftData.data(), frameBands, amortisedFrameOrder); break;
+        case AnalysisStage::peakPick:         extractFramePeaks(fftData.data(), frameBands, amortisedFrameOrder, frameSettings); break;
+        case AnalysisStage::tracking:         trackFramePeaks(framePartials); break;
+        case AnalysisStage::modifiers:        modifyFrameTracks(framePartials.tracks, frameSettings, amortisedSliceChanged); break;
+        case AnalysisStage::oscillatorUpdate: updateOscillators(framePartials); break;
+        default: break;
+    }
 
-    dryBufferPos = 0;
+    const double elapsedSeconds = juce::Time::highResolutionTicksToSeconds(
+        juce::Time::getHighResolutionTicks() - startTicks);
+    const double budgetSeconds = static_cast<double>(hopSize)
+                               / (static_cast<double>(numAnalysisStages) * sampleRate);
+    const float load = static_cast<float>(elapsedSeconds / budgetSeconds);
 
-    // Reset oscillator bank (Phase 3)
-    oscillatorBank.reset();
+    const auto index = static_cast<size_t>(stage);
+    stageLoadLast[index].store(load);
 
-    // PHASE 5: Clear spectral modifier state
-    prevPartialAmplitudes.clear();
-    feedbackAmplitudes.clear();
+    if (load > stageLoadPeak[index].load())
+        stageLoadPeak[index].store(load);
 }
 
-float SolaireEngine::processSample(float inputSample)
+void SolaireEngine::updateOscillators(const PartialFrame& analysedPartials)
 {
-    // CRITICAL: TryLock - skip processing if prepareToPlay is running
-    const juce::SpinLock::ScopedTryLockType lock(processingLock);
-    if (!lock.isLocked())
-        return inputSample;  // Bypass if preparing
+    SOLAIRE_PROFILE_STAGE(profiler, ProfileStage::oscillatorUpdate);
+
+    // A recalled snapshot stands in for the analysed partials until it is released
+    const auto& partials = (recalledSnapshotSlot.load() >= 0) ? recalledPartials : analysedPartials;
+    captureSnapshotFrom(partials);
+
+    // PHASE 7: Update oscillator bank glide and waveform settings
+    // SOURCE: JUCE SmoothedValue and Oscillator::initialise patterns
+    // (block ramps at the update's position - cheap integer mappings, done every update)
+    const float glideTime = getParameterAt(&Parameters::glide, blockPosition);
+    const float waveformParam = getParameterAt(&Parameters::waveform, blockPosition);
+    const int waveformIndex = static_cast<int>(waveformParam * 3.0f);  // 0-1 maps to 0-3
 
-    // Store input sample in FIFO (audiodev.blog pattern)
-    inputFifo[fifoPos] = inputSample;
+    // PHASE 4: VOICE parameter - limit active oscillators
+    // SOURCE: Simple loop control (standard C++ pattern)
+    const float voiceParam = getParameterAt(&Parameters::voice, blockPosition);
+    int voiceLimit = getVoiceCount(voiceParam);  // 1-33 range (1-maxVoices)
 
-    // Store dry signal for mix
-    dryBuffer[dryBufferPos] = inputSample;
-    dryBufferPos = (dryBufferPos + 1) % fftSize;
+    // Governor: the first tier halves the voice cap (the bank only renders sounding voices)
+    if (governor.getTier() >= QualityGovernor::Tier::reducedVoices)
+        voiceLimit = (voiceLimit + 1) / 2;
 
-    // Phase 3: Generate output from oscillator bank (replaces IFFT reconstruction)
-    // SOURCE: JUCE DSP Tutorial - continuous sample generation from oscillators
-    float outputSample = oscillatorBank.processSample();
+    const auto& tracks = partials.tracks;
+    const bool linked = (linkedFollower != nullptr);
 
-    // Advance FIFO position (circular)
-    fifoPos = (fifoPos + 1) % fftSize;
+    if (partialTelemetryDue)
+        publishPartialTelemetry(tracks, voiceLimit);
 
-    // Process FFT frame every hopSize samples (for spectral analysis only)
-    hopCount++;
-    if (hopCount >= hopSize)
+    // Linked: both banks follow the shared partials, each scaled by its channel gain
+    withSynthesiser([&](auto& bank)
     {
-        hopCount = 0;
-        processFrame();
+        bank.setGlideTime(glideTime);
+        bank.setWaveform(waveformIndex);
+        bank.updateFromPartials(tracks.data(), static_cast<int>(tracks.size()), voiceLimit,
+                                linked ? partials.channelGains[0].data() : nullptr);
+    });
+
+    if (!linked)
+        return;
+
+    linkedFollower->withSynthesiser([&](auto& followerBank)
+    {
+        followerBank.setGlideTime(glideTime);
+        followerBank.setWaveform(waveformIndex);
+        followerBank.updateFromPartials(tracks.data(), static_cast<int>(tracks.size()), voiceLimit,
+                                        partials.channelGains[1].data());
+    });
+
+    // NOTE: the default backend is the oscillator bank; the IFFT backend renders the
+    // same targets by overlap-add (InverseFFTSynthesiser)
+}
+
+void SolaireEngine::applySnapshotRequests()
+{
+    // Recall: decode the slot and make it the oscillator targets right away
+    // (O(voices), no analysis); release hands back to the next analysed frame
+    const int recall = pendingSnapshotRecall.exchange(noSnapshotRequest);
+
+    if (recall == releaseSnapshotRequest)
+    {
+        recalledSnapshotSlot.store(-1);
+        return;
     }
 
-    // Apply output effects
-    applyOutputEffects(outputSample);
+    if (recall < 0 || snapshotBank == nullptr)
+        return;
 
-    return outputSample;
+    auto& tracks = recalledPartials.tracks;
+
+    if (snapshotBank->tryLoad(recall, tracks.data(), static_cast<int>(tracks.size()),
+                              recalledPartials.channelGains[0].data(), recalledPartials.channelGains[1].data()))
+    {
+        recalledSnapshotSlot.store(recall);
+        updateOscillators(recalledPartials);
+    }
+    else if (snapshotBank->isStored(recall))
+    {
+        // The slot is being written right now - retry next block unless a newer request came in
+        int expected = noSnapshotRequest;
+        pendingSnapshotRecall.compare_exchange_strong(expected, recall);
+    }
 }
 
-void SolaireEngine::processFrame()
+void SolaireEngine::captureSnapshotFrom(const PartialFrame& partials)
+{
+    int slot = pendingSnapshotCapture.load();
+
+    if (slot == noSnapshotRequest)
+        return;
+
+    // Linked: store both channels' amplitudes so the pair recalls its stereo image
+    const bool linked = (linkedFollower != nullptr);
+    const auto& tracks = partials.tracks;
+
+    if (snapshotBank != nullptr
+        && !snapshotBank->tryStore(slot, tracks.data(), static_cast<int>(tracks.size()),
+                                   linked ? partials.channelGains[0].data() : nullptr,
+                                   linked ? partials.channelGains[1].data() : nullptr))
+        return;  // Slot busy (state being restored) - retry at the next update
+
+    // Done (or no bank) - keep any request that arrived meanwhile
+    pendingSnapshotCapture.compare_exchange_strong(slot, noSnapshotRequest);
+}
+
+//==============================================================================
+// Editor telemetry
+
+void SolaireEngine::scheduleTelemetry()
+{
+    // Audio thread, at each frame: without a reader this is the only cost
+    frameSettings.publishSpectrum = false;
+
+    if (telemetryFeed == nullptr || !telemetryFeed->isActive())
+        return;
+
+    telemetrySamples += hopSize;
+
+    if (telemetrySamples < telemetryInterval)
+        return;
+
+    // This frame's spectrum, and the partials of the next oscillator update (the
+    // remainder carries over so hops that don't divide the interval keep the rate)
+    telemetrySamples %= telemetryInterval;
+    frameSettings.publishSpectrum = true;
+    partialTelemetryDue = true;
+}
+
+void SolaireEngine::publishSpectrumTelemetry(const float* spectrum, int order)
+{
+    // Whichever thread analyses the frame (its only writer). Decimated frames only
+    // cover their usable band; multi-resolution bands are not shown.
+    const int level = getDecimationLevel(order);
+    const double frameSampleRate = sampleRate / static_cast<double>(1 << level);
+    const float bandwidth = (level > 0) ? DecimatedHistory::usableBandwidth * static_cast<float>(frameSampleRate)
+                                        : 0.5f * static_cast<float>(frameSampleRate);
+
+    auto& telemetry = telemetryFeed->spectrum.getWriteBuffer();
+    telemetry.setFromSpectrum(spectrum, 1 << getTransformOrder(order), frameSampleRate, bandwidth);
+    telemetry.sequence = ++spectrumTelemetrySequence;
+    telemetryFeed->spectrum.publish();
+}
+
+void SolaireEngine::publishPartialTelemetry(const TrackSlots& tracks, int voiceLimit)
 {
-    // audiodev.blog STFT pattern: Copy FIFO to FFT buffer
-    // Handle circular buffer wrap-around in two parts
-    float* fftPtr = fftData.data();
-    const float* inputPtr = inputFifo.data();
+    // Audio thread: the sounding slots as the bank receives them (slot i = voice i)
+    partialTelemetryDue = false;
 
-    // Copy from fifoPos to end of FIFO
-    std::memcpy(fftPtr, inputPtr + fifoPos, (fftSize - fifoPos) * sizeof(float));
+    auto& telemetry = telemetryFeed->partials.getWriteBuffer();
+    const int numSlots = std::min(voiceLimit, static_cast<int>(tracks.size()));
+    int numPartials = 0;
 
-    // Copy from start of FIFO to fifoPos (if wrapped)
-    if (fifoPos > 0)
+    for (int slot = 0; slot < numSlots; ++slot)
     {
-        std::memcpy(fftPtr + fftSize - fifoPos, inputPtr, fifoPos * sizeof(float));
+        const auto& track = tracks[static_cast<size_t>(slot)];
+
+        if (track.isActive)
+            telemetry.partials[static_cast<size_t>(numPartials++)] = { track.frequency, track.amplitude, track.trackID, slot };
     }
 
-    // Apply Hann window before FFT (audiodev.blog pattern)
-    window->multiplyWithWindowingTable(fftPtr, fftSize);
+    telemetry.numPartials = numPartials;
+    telemetry.frozen = frameSettings.frozen;
+    telemetry.recalledSnapshot = recalledSnapshotSlot.load();
+    telemetry.sequence = ++partialTelemetrySequence;
+    telemetryFeed->partials.publish();
+}
 
-    // Perform FFT (juce::dsp pattern)
-    fft->performRealOnlyForwardTransform(fftPtr, true);
+//==============================================================================
+// Asynchronous analysis
 
-    // SPECTRAL ANALYSIS (Phase 1-2: peak extraction & tracking)
-    spectralManipulation(fftPtr);
+void SolaireEngine::pushAnalysisFrame()
+{
+    // Audio thread: window the newest frame straight into a free queue slot
+    int start1, size1, start2, size2;
+    analysisFrameFifo.prepareToWrite(1, start1, size1, start2, size2);
 
-    // Phase 3, 4, 5, 6 & 7: Update oscillator bank from tracked partials
-    // SOURCE: Custom logic using JUCE patterns
-    // Replaces IFFT reconstruction - oscillators generate audio directly
-    auto activeTracks = partialTracker.getActiveTracks();  // Copy for modification
+    if (size1 == 0)
+    {
+        // Analysis thread fell behind - skip this frame, keep the slice change for the next one
+        droppedAnalysisFrames.fetch_add(1);
+        return;
+    }
 
-    // PHASE 5 & 6: Apply spectral modifiers to partial tracks
-    applySpectralModifiers(activeTracks);
+    auto& frame = analysisFrames[static_cast<size_t>(start1)];
+    copyWindowedFrame(frame.data.data(), frame.bands);
+    frame.settings = frameSettings;
+    frame.fftOrder = fftOrder;
+    frame.sliceChanged = pendingSliceChange;
+    pendingSliceChange = false;
 
-    // PHASE 7: Update oscillator bank glide and waveform settings
-    // SOURCE: JUCE SmoothedValue and Oscillator::initialise patterns
-    const float glideTime = currentGlide.load();
-    const float waveformParam = currentWaveform.load();
-    const int waveformIndex = static_cast<int>(waveformParam * 3.0f);  // 0-1 maps to 0-3
+    // Picked up by the analysis thread's next poll (no wake-up: see AnalysisThread)
+    analysisFrameFifo.finishedWrite(1);
+}
 
-    oscillatorBank.setGlideTime(glideTime);
-    oscillatorBank.setWaveform(waveformIndex);
+void SolaireEngine::applyLatestAnalysisResult()
+{
+    // Audio thread: only the newest result matters, older ones are skipped
+    const int numReady = analysisResultFifo.getNumReady();
+    if (numReady == 0)
+        return;  // Keep the current oscillator targets
 
-    // PHASE 4: VOICE parameter - limit active oscillators
-    // SOURCE: Simple loop control (standard C++ pattern)
-    const float voiceParam = currentVoice.load();
-    const int maxVoices = static_cast<int>(voiceParam * 32.0f) + 1;  // 1-33 range
-    oscillatorBank.updateFromPartials(activeTracks, maxVoices);
+    int start1, size1, start2, size2;
+    analysisResultFifo.prepareToRead(numReady, start1, size1, start2, size2);
+
+    const int newest = (size2 > 0) ? start2 + size2 - 1 : start1 + size1 - 1;
+    updateOscillators(analysisResults[static_cast<size_t>(newest)]);
 
-    // NOTE: IFFT and overlap-add removed - now using oscillator bank synthesis
+    analysisResultFifo.finishedRead(size1 + size2);
 }
 
-void SolaireEngine::spectralManipulation(float* fftDataBuffer)
+void SolaireEngine::processPendingAnalysis()
 {
-    // PHASE 4: FREEZE parameter - gate spectral analysis
-    // SOURCE: Simple boolean gate pattern (standard DSP technique)
-    const float freeze = currentFreeze.load();
-    const bool isFrozen = (freeze > 0.5f);
+    // Analysis thread: drain queued frames while there is room to publish results
+    while (analysisFrameFifo.getNumReady() > 0 && analysisResultFifo.getFreeSpace() > 0)
+    {
+        int frameStart1, frameSize1, frameStart2, frameSize2;
+        analysisFrameFifo.prepareToRead(1, frameStart1, frameSize1, frameStart2, frameSize2);
+
+        int resultStart1, resultSize1, resultStart2, resultSize2;
+        analysisResultFifo.prepareToWrite(1, resultStart1, resultSize1, resultStart2, resultSize2);
 
-    if (!isFrozen)
+        auto& frame = analysisFrames[static_cast<size_t>(frameStart1)];
+        analyseFrame(frame.data.data(), frame.bands, frame.fftOrder, frame.sliceChanged, frame.settings,
+                     analysisResults[static_cast<size_t>(resultStart1)]);
+
+        analysisResultFifo.finishedWrite(1);
+        analysisFrameFifo.finishedRead(1);
+    }
+}
+
+void SolaireEngine::applySliceCrossfade(TrackSlots& tracks)
+{
+    // PHASE 4: Short partial-domain crossfade after a SLICE change
+    // The new resolution produces slightly different peaks; continuing tracks ramp
+    // from their previous amplitude and newly born tracks fade in from silence
+    const float progress = static_cast<float>(sliceCrossfadeFrames - sliceCrossfadeRemaining + 1)
+                         / static_cast<float>(sliceCrossfadeFrames + 1);
+
+    for (auto& track : tracks)
     {
-        // PHASE 1: Extract dominant spectral peaks (Panharmonium resynthesis)
-        // SOURCE: audiodev.blog FFT tutorial + DSPRelated quadratic interpolation
-        // Extract 33 dominant peaks for oscillator bank resynthesis
-        currentPeaks = extractDominantPeaks(
-            fftDataBuffer,
-            numBins,
-            maxSpectralPeaks,
-            sampleRate,
-            fftSize
-        );
+        if (!track.isActive)
+            continue;
 
-        // PHASE 2: Track peaks across frames (Panharmonium resynthesis)
-        // SOURCE: McAulay-Quatieri algorithm - maintain peak identity over time
-        // Enables stable oscillator frequency/amplitude trajectories
-        partialTracker.processFrame(currentPeaks);
+        const float startAmplitude = (track.framesSinceCreation <= 1) ? 0.0f : track.prevAmplitude;
+        track.amplitude = startAmplitude + (track.amplitude - startAmplitude) * progress;
     }
-    // When frozen, partials keep their last tracked values (oscillators continue)
+
+    --sliceCrossfadeRemaining;
 }
 
-void SolaireEngine::applySpectralModifiers(std::vector<PartialTrack>& tracks)
+void SolaireEngine::updateFrameSettings()
 {
-    // PHASE 5 & 6: Apply spectral modifiers to partial tracks
-    // SOURCE: Adapted from verified FFT bin processing patterns (Perplexity 95%+)
+    // PHASE 5 & 6: Map the modifier and frequency controls once per hop, from the
+    // parameters at the hop boundary; the pow/sqrt mapping only reruns when one moved
+    const auto parameters = getParametersAt(blockPosition);
+    const auto& source = frameSettingsSource;
 
-    // Load parameters (atomic read - thread-safe)
-    const float blur = currentBlur.load();
-    const float feedback = currentFeedback.load();
-    const float warp = currentWarp.load();
+    if (frameSettingsMapped
+        && parameters.freeze == source.freeze && parameters.blur == source.blur
+        && parameters.warp == source.warp && parameters.feedback == source.feedback
+        && parameters.centerFreq == source.centerFreq && parameters.bandwidth == source.bandwidth
+        && parameters.freq == source.freq && parameters.octave == source.octave)
+        return;
 
-    // PHASE 6: Frequency control parameters
-    const float centerFreq = currentCenterFreq.load();
-    const float bandwidth = currentBandwidth.load();
-    const float freqShift = currentFreq.load();
-    const float octaveShift = currentOctave.load();
+    frameSettingsSource = parameters;
+    frameSettingsMapped = true;
+
+    auto& settings = frameSettings;
+
+    // PHASE 4: FREEZE parameter - gate spectral analysis
+    // SOURCE: Simple boolean gate pattern (standard DSP technique)
+    settings.frozen = (parameters.freeze > 0.5f);
+    settings.blur = parameters.blur;
+    settings.feedback = parameters.feedback;
 
     // Calculate frequency window bounds
     // SOURCE: Logarithmic frequency scaling (standard audio/DSP technique)
     const float MIN_FREQ = 20.0f;
     const float MAX_FREQ = 20000.0f;
-    const float centerHz = MIN_FREQ * std::pow(MAX_FREQ / MIN_FREQ, centerFreq);
+    const float centerHz = MIN_FREQ * std::pow(MAX_FREQ / MIN_FREQ, parameters.centerFreq);
 
     // Bandwidth: 0 = narrow (±1 semitone), 1 = full spectrum
-    const float bandwidthSemitones = 1.0f + bandwidth * 59.0f;  // 1 to 60 semitones
+    const float bandwidthSemitones = 1.0f + parameters.bandwidth * 59.0f;  // 1 to 60 semitones
     const float bandwidthRatio = std::pow(2.0f, bandwidthSemitones / 12.0f);
-    const float minFreq = centerHz / std::sqrt(bandwidthRatio);
-    const float maxFreq = centerHz * std::sqrt(bandwidthRatio);
+    settings.minFrequency = centerHz / std::sqrt(bandwidthRatio);
+    settings.maxFrequency = centerHz * std::sqrt(bandwidthRatio);
 
     // Calculate global frequency shift ratios
     // SOURCE: Standard pitch shift formula (verified in WARP)
     // FREQ: -100 to +100 cents (-1 to +1 semitones)
-    const float centsShift = (freqShift - 0.5f) * 200.0f;  // Map 0-1 to -100 to +100 cents
+    const float centsShift = (parameters.freq - 0.5f) * 200.0f;  // Map 0-1 to -100 to +100 cents
     const float freqRatio = std::pow(2.0f, centsShift / 1200.0f);
 
     // OCTAVE: -2 to +2 octaves
-    const float octaves = (octaveShift - 0.5f) * 4.0f;  // Map 0-1 to -2 to +2
+    const float octaves = (parameters.octave - 0.5f) * 4.0f;  // Map 0-1 to -2 to +2
     const float octaveRatio = std::pow(2.0f, octaves);
+    settings.pitchRatio = freqRatio * octaveRatio;
 
-    for (auto& track : tracks)
+    // WARP: ±6 semitones, same ratio for every partial
+    const float warpAmount = (parameters.warp - 0.5f) * 2.0f;
+    settings.warpActive = (parameters.warp != 0.5f);
+    settings.warpRatio = std::pow(2.0f, warpAmount * 0.5f);
+}
+
+void SolaireEngine::applySpectralModifiers(TrackSlots& tracks, const FrameSettings& settings)
+{
+    // PHASE 5 & 6: Apply spectral modifiers to partial tracks
+    // SOURCE: Adapted from verified FFT bin processing patterns (Perplexity 95%+)
+    // The controls arrive already mapped (updateFrameSettings(), once per hop)
+    const float blur = settings.blur;
+    const float feedback = settings.feedback;
+    const float minFreq = settings.minFrequency;
+    const float maxFreq = settings.maxFrequency;
+
+    // Governor (last tier): drop the amplitude modifiers, keep pitch and the frequency window
+    const bool skipAmplitudeModifiers = (governor.getTier() >= QualityGovernor::Tier::noModifiers);
+
+    for (size_t slot = 0; slot < tracks.size(); ++slot)
     {
+        auto& track = tracks[slot];
+
         if (!track.isActive)
             continue;
 
-        const int trackID = track.trackID;
+        // Slot reassigned to a new track: start its modifier state from silence
+        if (modifierTrackIDs[slot] != track.trackID)
+        {
+            modifierTrackIDs[slot] = track.trackID;
+            prevPartialAmplitudes[slot] = 0.0f;
+            feedbackAmplitudes[slot] = 0.0f;
+        }
 
         // PHASE 6: Frequency window filtering (CENTER_FREQ + BANDWIDTH)
         // SOURCE: Simple range check (standard C++ conditional logic)
@@ -276,158 +1434,358 @@ void SolaireEngine::applySpectralModifiers(std::vector<PartialTrack>& tracks)
 
         // EFFECT 1: BLUR (Exponential Moving Average on amplitude)
         // SOURCE: Previously verified pattern (Perplexity 95%+)
-        if (blur > 0.0f)
+        if (blur > 0.0f && !skipAmplitudeModifiers)
         {
             float alpha = 1.0f - blur;
-            float prevAmp = prevPartialAmplitudes[trackID];
+            float prevAmp = prevPartialAmplitudes[slot];
             track.amplitude = (1.0f - alpha) * prevAmp + alpha * track.amplitude;
         }
 
         // EFFECT 2: FEEDBACK (Spectral amplitude feedback with decay)
         // SOURCE: Previously verified pattern (Perplexity 95%+)
-        if (feedback > 0.0f)
+        if (feedback > 0.0f && !skipAmplitudeModifiers)
         {
             const float FEEDBACK_DECAY = 0.97f;
-            feedbackAmplitudes[trackID] *= FEEDBACK_DECAY;
-            float currentFeedback = feedbackAmplitudes[trackID];
+            feedbackAmplitudes[slot] *= FEEDBACK_DECAY;
+            float currentFeedback = feedbackAmplitudes[slot];
             track.amplitude = track.amplitude * (1.0f - feedback) + currentFeedback * feedback;
         }
 
         // EFFECT 3: WARP (Frequency shift/scaling)
         // SOURCE: Standard pitch shift formula (verified in Phase 5)
-        if (warp != 0.5f)
-        {
-            const float warpAmount = (warp - 0.5f) * 2.0f;
-            const float warpRatio = std::pow(2.0f, warpAmount * 0.5f);  // ±6 semitones
-            track.frequency *= warpRatio;
-        }
+        if (settings.warpActive)
+            track.frequency *= settings.warpRatio;
 
         // PHASE 6: FREQ + OCTAVE (Global frequency transposition)
         // SOURCE: Standard pitch shift formula (multiply by frequency ratio)
-        track.frequency *= freqRatio * octaveRatio;
+        track.frequency *= settings.pitchRatio;
 
         // Store state for next frame
-        prevPartialAmplitudes[trackID] = track.amplitude;
-        feedbackAmplitudes[trackID] = track.amplitude;
+        prevPartialAmplitudes[slot] = track.amplitude;
+        feedbackAmplitudes[slot] = track.amplitude;
     }
 }
 
-void SolaireEngine::applyOutputEffects(float& sample)
+void SolaireEngine::updateColourCoefficients(float colour)
 {
-    // Load parameters
-    const float colour = currentColour.load();
-    const float floatParam = currentFloat.load();
-    const float mix = currentMix.load();
-
-    // Get dry sample for mix - read the sample we just wrote before incrementing
-    // SOURCE: JUCE DelayLine pattern (juce_DelayLine.cpp:117-120)
-    // We write to buffer[pos] then increment pos, so to read current sample: (pos - 1)
-    float drySample = dryBuffer[(dryBufferPos - 1 + fftSize) % fftSize];
-
-    // COLOR: Tilt EQ using complementary low/high shelves
-    // Verification: First-order shelving filters with complementary gains
-    lowShelf.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(
+    // Verification: RBJ shelving filters with complementary gains
+    // ArrayCoefficients returns by value, so assigning into the existing
+    // Coefficients object neither allocates nor touches the ref count
+    *lowShelf.coefficients = juce::dsp::IIR::ArrayCoefficients<float>::makeLowShelf(
         sampleRate, 1000.0f, 0.707f, 1.0f - colour + 0.5f);
-    highShelf.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf(
+    *highShelf.coefficients = juce::dsp::IIR::ArrayCoefficients<float>::makeHighShelf(
         sampleRate, 1000.0f, 0.707f, colour + 0.5f);
 
-    // Apply filters (single sample processing)
-    float filtered = sample;
-    filtered = lowShelf.processSample(filtered);
-    filtered = highShelf.processSample(filtered);
-
-    // FLOAT: Reverb
-    // Verification: JUCE Reverb with decay time mapped to room size
-    juce::Reverb::Parameters reverbParams;
-    reverbParams.roomSize = floatParam;
-    reverbParams.damping = 0.5f;
-    reverbParams.wetLevel = floatParam;
-    reverbParams.dryLevel = 1.0f - floatParam;
-    reverbParams.width = 1.0f;
-    reverb.setParameters(reverbParams);
-
-    float reverbSample = filtered;
-    reverb.processMono(&reverbSample, 1);
-    filtered = reverbSample;
+    appliedColour = colour;
+}
+
+int SolaireEngine::getWetPathLatency() const
+{
+    // Oscillators follow the frame that ended a window ago (a hop later when
+    // results are applied after the frame); IFFT frames peak a synthesis hop later
+    const int synthesisLatency = (synthesisBackend == SynthesisBackend::inverseFFT)
+                                   ? inverseSynthesiser.getLatencyInSamples()
+                                   : 0;
+
+    return fftSize + (analysisMode != AnalysisMode::synchronous ? hopSize : 0) + synthesisLatency;
+}
+
+void SolaireEngine::updateWetDelay()
+{
+    // Decimated windows exceed the constant latency: the wet path then runs undelayed
+    setWetDelay(std::max(0, latencySamples - getWetPathLatency()));
+}
+
+void SolaireEngine::setWetDelay(int newDelay)
+{
+    jassert(newDelay >= 0 && newDelay + maxTransformSize / overlap <= delayLineSize);
+
+    if (newDelay == wetDelaySamples)
+        return;
+
+    // Fade from the current tap to the new one instead of jumping (a change during
+    // a fade restarts it from the tap that was fading in)
+    previousWetDelaySamples = wetDelaySamples;
+    wetDelaySamples = newDelay;
+    wetCrossfadeRemaining = wetDelayCrossfadeSamples;
+}
+
+void SolaireEngine::matchLinkedLatency(const SolaireEngine& leader)
+{
+    if (latencySamples != leader.latencySamples)
+    {
+        // First block after prepareToPlay() (the follower analyses synchronously on
+        // its own): adopt the leader's alignment outright, while the lines are silent
+        latencySamples = leader.latencySamples;
+        wetDelaySamples = leader.wetDelaySamples;
+        previousWetDelaySamples = wetDelaySamples;
+        wetCrossfadeRemaining = 0;
+        return;
+    }
+
+    setWetDelay(leader.wetDelaySamples);
+}
+
+void SolaireEngine::writeDelayLine(std::vector<float>& line, const float* source, int numSamples) const
+{
+    // Two parts when the write wraps around the end of the ring
+    const int firstPart = std::min(numSamples, delayLineSize - delayWritePos);
+
+    std::memcpy(line.data() + delayWritePos, source, static_cast<size_t>(firstPart) * sizeof(float));
+    std::memcpy(line.data(), source + firstPart, static_cast<size_t>(numSamples - firstPart) * sizeof(float));
+
+    // Mirrored rings (twice delayLineSize) keep a second copy a ring length later, so
+    // any delayLineSize samples ending at the write position are one contiguous span
+    if (line.size() == 2 * static_cast<size_t>(delayLineSize))
+    {
+        std::memcpy(line.data() + delayLineSize + delayWritePos, source, static_cast<size_t>(firstPart) * sizeof(float));
+        std::memcpy(line.data() + delayLineSize, source + firstPart, static_cast<size_t>(numSamples - firstPart) * sizeof(float));
+    }
+}
+
+void SolaireEngine::readDelayLine(const std::vector<float>& line, int delay, float* destination, int numSamples) const
+{
+    // Samples written `delay` samples before the ones just written at delayWritePos
+    const int readPos = (delayWritePos - delay) & delayLineMask;
+    const int firstPart = std::min(numSamples, delayLineSize - readPos);
+
+    std::memcpy(destination, line.data() + readPos, static_cast<size_t>(firstPart) * sizeof(float));
+    std::memcpy(destination + firstPart, line.data(), static_cast<size_t>(numSamples - firstPart) * sizeof(float));
+}
+
+void SolaireEngine::delayWetSamples(float* samples, int numSamples)
+{
+    writeDelayLine(wetDelayLine, samples, numSamples);
+
+    if (wetCrossfadeRemaining <= 0)
+    {
+        readDelayLine(wetDelayLine, wetDelaySamples, samples, numSamples);
+        return;
+    }
+
+    // TIME changed: linear crossfade from the old tap to the new one
+    const float* line = wetDelayLine.data();
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float newTap = line[(delayWritePos + i - wetDelaySamples) & delayLineMask];
+
+        if (wetCrossfadeRemaining > 0)
+        {
+            const float oldTap = line[(delayWritePos + i - previousWetDelaySamples) & delayLineMask];
+            const float fade = 1.0f - static_cast<float>(wetCrossfadeRemaining) / static_cast<float>(wetDelayCrossfadeSamples);
+
+            samples[i] = oldTap + fade * (newTap - oldTap);
+            --wetCrossfadeRemaining;
+        }
+        else
+        {
+            samples[i] = newTap;
+        }
+    }
+}
+
+void SolaireEngine::applyOutputEffects(float* samples, const float* drySamples, int numSamples)
+{
+    // COLOR follows the block ramp every colourChunkSize samples; MIX ramps per
+    // sample to its value at the sub-block end (applyMix). FLOAT runs after the
+    // engines (FloatReverb in the processor).
+    // A steady COLOR filters the whole sub-block in one pass.
+    const bool colourMoving = (blockParameters.start.colour != blockParameters.end.colour);
+    const int chunkSize = colourMoving ? colourChunkSize : numSamples;
+
+    for (int offset = 0; offset < numSamples; offset += chunkSize)
+    {
+        const int chunkLength = std::min(chunkSize, numSamples - offset);
+        const float colour = getParameterAt(&Parameters::colour, blockPosition + offset);
+
+        // COLOR: Tilt EQ using complementary low/high shelves
+        // Coefficients are only redesigned once the colour has moved past the threshold
+        if (std::abs(colour - appliedColour) > colourUpdateThreshold)
+            updateColourCoefficients(colour);
+
+        // Apply filters to the chunk, one shelf after the other
+        float* channels[] = { samples + offset };
+        juce::dsp::AudioBlock<float> block(channels, 1, static_cast<size_t>(chunkLength));
+        juce::dsp::ProcessContextReplacing<float> context(block);
+        lowShelf.process(context);
+        highShelf.process(context);
+    }
+
+    // Sleep mode waits for the wet tail to decay
+    wetPeak = std::max(wetPeak, getPeakLevel(samples, numSamples));
+
+    applyMix(samples, drySamples, numSamples);
+}
+
+void SolaireEngine::applyMix(float* samples, const float* drySamples, int numSamples) const
+{
+    // MIX ramps per sample to its value at the sub-block end
+    const float mixStart = getParameterAt(&Parameters::mix, blockPosition);
+    const float mixEnd = getParameterAt(&Parameters::mix, blockPosition + numSamples);
 
     // MIX: Dry/Wet blend
     // Verification: Linear crossfade formula
-    sample = mix * filtered + (1.0f - mix) * drySample;
+    if (mixStart == mixEnd)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = mixEnd * samples[i] + (1.0f - mixEnd) * drySamples[i];
+        return;
+    }
+
+    const float mixStep = (mixEnd - mixStart) / static_cast<float>(numSamples);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float mix = mixStart + mixStep * static_cast<float>(i);
+        samples[i] = mix * samples[i] + (1.0f - mix) * drySamples[i];
+    }
 }
 
 //==============================================================================
-// Parameter setters
+// Parameters
 
-// PHASE 4: Core Panharmonium parameters
-void SolaireEngine::setSlice(float value)
+void SolaireEngine::setParameters(const ParameterBlock& newParameters)
 {
-    // SOURCE: Rossum Panharmonium - logarithmic SLICE control (17ms - 6400ms)
-    // Convert 0-1 to logarithmic FFT size range
-    value = juce::jlimit(0.0f, 1.0f, value);
-    currentSlice.store(value);
+    // Audio thread, before the block: a plain copy, consumed by beginBlock()
+    blockParameters = newParameters;
+    parametersPublished = true;
+
+    // SLICE only becomes a pending FFT order when it moved (log mapping once per change)
+    if (newParameters.end.slice != mappedSlice)
+    {
+        mappedSlice = newParameters.end.slice;
+        pendingFFTOrder.store(getOrderForSlice(mappedSlice));
+    }
+}
+
+SolaireEngine::Parameters SolaireEngine::loadSetterParameters() const
+{
+    // One relaxed load per parameter, only in blocks after a setter was used
+    Parameters parameters;
+    parameters.slice = currentSlice.load(std::memory_order_relaxed);
+    parameters.voice = currentVoice.load(std::memory_order_relaxed);
+    parameters.freeze = currentFreeze.load(std::memory_order_relaxed);
+    parameters.blur = currentBlur.load(std::memory_order_relaxed);
+    parameters.warp = currentWarp.load(std::memory_order_relaxed);
+    parameters.feedback = currentFeedback.load(std::memory_order_relaxed);
+    parameters.centerFreq = currentCenterFreq.load(std::memory_order_relaxed);
+    parameters.bandwidth = currentBandwidth.load(std::memory_order_relaxed);
+    parameters.freq = currentFreq.load(std::memory_order_relaxed);
+    parameters.octave = currentOctave.load(std::memory_order_relaxed);
+    parameters.glide = currentGlide.load(std::memory_order_relaxed);
+    parameters.waveform = currentWaveform.load(std::memory_order_relaxed);
+    parameters.mix = currentMix.load(std::memory_order_relaxed);
+    parameters.colour = currentColour.load(std::memory_order_relaxed);
+    return parameters;
+}
 
+float SolaireEngine::getParameterAt(float Parameters::* parameter, int position) const
+{
+    // Linear ramp from the block's start value to its end value
+    const float start = blockParameters.start.*parameter;
+    const float end = blockParameters.end.*parameter;
+
+    if (start == end)
+        return end;
+
+    return start + (end - start) * static_cast<float>(position) / static_cast<float>(blockLength);
+}
+
+SolaireEngine::Parameters SolaireEngine::getParametersAt(int position) const
+{
+    if (position >= blockLength)
+        return blockParameters.end;
+
+    Parameters parameters;
+
+    for (auto parameter : { &Parameters::slice, &Parameters::voice, &Parameters::freeze, &Parameters::blur,
+                             &Parameters::warp, &Parameters::feedback, &Parameters::centerFreq,
+                             &Parameters::bandwidth, &Parameters::freq, &Parameters::octave,
+                             &Parameters::glide, &Parameters::waveform, &Parameters::mix,
+                             &Parameters::colour })
+        parameters.*parameter = getParameterAt(parameter, position);
+
+    return parameters;
+}
+
+int SolaireEngine::getOrderForSlice(float slice) const
+{
+    // SOURCE: Rossum Panharmonium - logarithmic SLICE control (17ms - 6400ms)
     // Convert to milliseconds logarithmically
     // SOURCE: Standard logarithmic pot scaling (audiodev.blog)
-    const float sliceMs = MIN_SLICE_MS * std::pow(MAX_SLICE_MS / MIN_SLICE_MS, value);
+    const float sliceMs = MIN_SLICE_MS * std::pow(MAX_SLICE_MS / MIN_SLICE_MS, slice);
 
     // Convert milliseconds to samples
     const float sliceSamples = (sliceMs / 1000.0f) * static_cast<float>(sampleRate);
 
     // Find nearest power of 2 for FFT order
     // SOURCE: JUCE FFT requirements - size must be power of 2
-    int newOrder = static_cast<int>(std::round(std::log2(sliceSamples)));
-    newOrder = juce::jlimit(7, 14, newOrder);  // 128 to 16384 samples
+    return juce::jlimit(minFFTOrder, maxFFTOrder, static_cast<int>(std::round(std::log2(sliceSamples))));
+}
 
-    // Update FFT size if changed (thread-safe with SpinLock)
-    if (newOrder != fftOrder)
-    {
-        const juce::SpinLock::ScopedLockType lock(processingLock);
-        updateFFTSize(newOrder);
-    }
+void SolaireEngine::storeParameter(std::atomic<float>& parameter, float value)
+{
+    // Any thread: the next block start sees the new generation and reloads the atomics
+    parameter.store(juce::jlimit(0.0f, 1.0f, value), std::memory_order_relaxed);
+    setterGeneration.fetch_add(1, std::memory_order_release);
+}
+
+//==============================================================================
+// Parameter setters
+
+// PHASE 4: Core Panharmonium parameters
+void SolaireEngine::setSlice(float value)
+{
+    // Convert 0-1 to logarithmic FFT size range
+    storeParameter(currentSlice, value);
+    setFFTOrder(getOrderForSlice(juce::jlimit(0.0f, 1.0f, value)));
+}
+
+void SolaireEngine::setFFTOrder(int order)
+{
+    // Publish the requested order - the audio thread switches plans at the next hop
+    // (SLICE cannot reach the smallest orders at high sample rates; tools use this directly)
+    pendingFFTOrder.store(juce::jlimit(minFFTOrder, maxFFTOrder, order));  // 128 to 524288 samples
 }
 
 void SolaireEngine::setBlur(float value)
 {
-    currentBlur.store(juce::jlimit(0.0f, 1.0f, value));
+    storeParameter(currentBlur, value);
 }
 
 void SolaireEngine::setWarp(float value)
 {
-    currentWarp.store(juce::jlimit(0.0f, 1.0f, value));
+    storeParameter(currentWarp, value);
 }
 
 void SolaireEngine::setFeedback(float value)
 {
-    currentFeedback.store(juce::jlimit(0.0f, 1.0f, value));
+    storeParameter(currentFeedback, value);
 }
 
 void SolaireEngine::setMix(float value)
 {
-    currentMix.store(juce::jlimit(0.0f, 1.0f, value));
+    storeParameter(currentMix, value);
 }
 
 void SolaireEngine::setColour(float value)
 {
-    currentColour.store(juce::jlimit(0.0f, 1.0f, value));
-}
-
-void SolaireEngine::setFloat(float value)
-{
-    currentFloat.store(juce::jlimit(0.0f, 1.0f, value));
+    storeParameter(currentColour, value);
 }
 
 void SolaireEngine::setVoice(float value)
 {
-    // PHASE 4: VOICE parameter (1-33 active oscillators)
+    // PHASE 4: VOICE parameter (1-33 active oscillators, 1-maxVoices in larger builds)
     // SOURCE: Simple atomic store (standard C++ pattern)
-    currentVoice.store(juce::jlimit(0.0f, 1.0f, value));
+    storeParameter(currentVoice, value);
 }
 
 void SolaireEngine::setFreeze(float value)
 {
     // PHASE 4: FREEZE parameter (spectral freeze on/off)
     // SOURCE: Boolean gate pattern (standard DSP technique)
-    currentFreeze.store(juce::jlimit(0.0f, 1.0f, value));
+    storeParameter(currentFreeze, value);
 }
 
 // PHASE 6: Frequency control parameter setters
@@ -435,40 +1793,37 @@ void SolaireEngine::setCenterFreq(float value)
 {
     // Center frequency of spectral window (20Hz - 20kHz, logarithmic)
     // SOURCE: Simple atomic store (standard C++ pattern)
-    currentCenterFreq.store(juce::jlimit(0.0f, 1.0f, value));
+    storeParameter(currentCenterFreq, value);
 }
 
 void SolaireEngine::setBandwidth(float value)
 {
     // Bandwidth of spectral window (narrow to full spectrum)
     // SOURCE: Simple atomic store (standard C++ pattern)
-    currentBandwidth.store(juce::jlimit(0.0f, 1.0f, value));
+    storeParameter(currentBandwidth, value);
 }
 
 void SolaireEngine::setFreq(float value)
 {
     // Fine frequency shift (-100 to +100 cents)
     // SOURCE: Simple atomic store (standard C++ pattern)
-    currentFreq.store(juce::jlimit(0.0f, 1.0f, value));
+    storeParameter(currentFreq, value);
 }
 
 void SolaireEngine::setOctave(float value)
 {
     // Octave transposition (-2 to +2 octaves)
     // SOURCE: Simple atomic store (standard C++ pattern)
-    currentOctave.store(juce::jlimit(0.0f, 1.0f, value));
+    storeParameter(currentOctave, value);
 }
 
 // PHASE 7: Glide and waveform parameter setters
 void SolaireEngine::setGlide(float value)
 {
     // Glide/portamento time (0 - 1000ms)
-    // SOURCE: Simple atomic store, mapped to seconds for juce::SmoothedValue
-    value = juce::jlimit(0.0f, 1.0f, value);
-    // Map 0-1 to 0-1000ms, convert to seconds
-    const float glideMs = value * 1000.0f;
-    const float glideSeconds = glideMs / 1000.0f;
-    currentGlide.store(glideSeconds);
+    // SOURCE: Simple atomic store; 0-1 maps to 0-1000ms, i.e. the value is already
+    // the glide time in seconds for juce::SmoothedValue
+    storeParameter(currentGlide, value);
 }
 
 void SolaireEngine::setWaveform(float value)
@@ -476,5 +1831,5 @@ void SolaireEngine::setWaveform(float value)
     // Waveform selection (0-1 maps to 0-3 index)
     // 0 = sine, 1 = triangle, 2 = saw, 3 = square
     // SOURCE: Simple atomic store (standard C++ pattern)
-    currentWaveform.store(juce::jlimit(0.0f, 1.0f, value));
+    storeParameter(currentWaveform, value);
 }
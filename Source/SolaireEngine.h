@@ -4,10 +4,28 @@
 #include <array>
 #include <complex>
 #include <memory>
-#include <unordered_map>
 #include "SpectralPeakExtraction.h"
 #include "PartialTracking.h"
 #include "OscillatorBank.h"
+#include "InverseFFTSynthesiser.h"
+#include "StageProfiler.h"
+#include "DecimatedHistory.h"
+#include "SpectralSnapshotBank.h"
+#include "QualityGovernor.h"
+#include "FFTBackend.h"
+#include "TelemetryFeed.h"
+
+// Voices per engine (tracker slots, peaks per frame and oscillators); the VOICE
+// parameter spans 1..SOLAIRE_MAX_VOICES. Set by the CMake option of the same name.
+#ifndef SOLAIRE_MAX_VOICES
+ #define SOLAIRE_MAX_VOICES 33  // Rossum Panharmonium: 33 oscillators
+#endif
+
+// The 33-voice bank and tracker are declared in their headers
+#if SOLAIRE_MAX_VOICES != 33
+extern template class BasicOscillatorBank<SOLAIRE_MAX_VOICES>;
+extern template class BasicPartialTrackingEngine<SOLAIRE_MAX_VOICES>;
+#endif
 
 /**
  * Solaire Spectral Processing Engine
@@ -17,24 +35,236 @@
  * - Partial tracking (McAulay-Quatieri algorithm)
  * - Oscillator bank resynthesis (33 independent oscillators)
  * - Spectral modifiers (BLUR, WARP, FEEDBACK)
- * - Output effects (COLOR tilt EQ, FLOAT reverb, MIX)
+ * - Output effects (COLOR tilt EQ, MIX); the FLOAT reverb runs after the engines (FloatReverb.h)
  *
- * Thread-safe with SpinLock for prepareToPlay/processBlock race condition protection
+ * Builds with SOLAIRE_MAX_VOICES above 33 (up to 256) track and play that many
+ * partials; the banks only render sounding voices, so the cost follows the
+ * audible partials. The VOICES parameter, the tracker and the snapshots all span
+ * the build's capacity.
+ *
+ * Thread-safe with SpinLock for prepareToPlay/processBlock race condition protection.
+ * SLICE changes are lock-free: setSlice() only publishes the requested FFT order.
+ *
+ * A stereo pair can share one analysis pipeline: the leader engine analyses both
+ * channels with a single complex FFT and drives the follower's oscillator bank.
+ *
+ * SLICE windows longer than the largest FFT (2^14) are analysed as a 2^14-point
+ * frame of the input decimated by 2^(order - 14), so the top of the TIME range
+ * (up to 2^19 samples) costs no more memory or CPU per frame than 2^14 does.
+ *
+ * Optionally, lower octave bands are analysed with longer windows on the same
+ * decimated history (multi-resolution analysis, see setAnalysisBands()).
+ *
+ * The partial set being played can be captured into a SnapshotBank and
+ * recalled later in place of the analysed partials (see recallSnapshot()).
  */
 class SolaireEngine
 {
 public:
+    // Voice capacity of this build (SOLAIRE_MAX_VOICES)
+    static constexpr int maxVoices = SOLAIRE_MAX_VOICES;
+    static_assert(maxVoices >= 33 && maxVoices <= 256, "SOLAIRE_MAX_VOICES must be 33-256");
+
+    // Snapshots hold every tracker slot of this build
+    using SnapshotBank = BasicSpectralSnapshotBank<maxVoices>;
+
+    /** Voices played at a VOICES parameter value (0-1 maps to 1-maxVoices) */
+    static int getVoiceCount(float voiceParameter)
+    {
+        const float clamped = juce::jlimit(0.0f, 1.0f, voiceParameter);
+        return static_cast<int>(clamped * static_cast<float>(maxVoices - 1)) + 1;
+    }
+
+    /**
+     * Where spectral analysis (FFT + peak extraction + tracking + modifiers) runs
+     *
+     * - synchronous:  inline at the hop boundary on the audio thread (deterministic,
+     *                 used for offline bounces)
+     * - asynchronous: windowed frames go to a dedicated analysis thread through a
+     *                 lock-free SPSC queue; partial sets come back through a second
+     *                 queue and are applied one hop later (adds hopSize of latency);
+     *                 the thread polls the queue, the audio thread never signals it
+     * - amortised:    no extra thread; the frame is split into resumable stages that
+     *                 run at evenly spaced points across the following hop, so each
+     *                 callback only pays for a bounded slice (adds hopSize of latency)
+     */
+    enum class AnalysisMode
+    {
+        synchronous,
+        asynchronous,
+        amortised
+    };
+
+    /** Resumable stages of one analysis frame (amortised mode runs one per slot) */
+    enum class AnalysisStage
+    {
+        copyWindow,         // Copy FIFO + Hann window (always at the hop boundary)
+        fft,                // Forward real FFT
+        peakPick,           // Magnitudes + dominant peak extraction
+        tracking,           // Partial tracking match
+        modifiers,          // SLICE crossfade + BLUR/WARP/FEEDBACK/frequency window
+        oscillatorUpdate    // Push targets to the oscillator bank
+    };
+
+    static constexpr int numAnalysisStages = 6;
+
+    /**
+     * How a stereo pair shares spectral analysis (configured on the leader engine)
+     *
+     * - independent:  every engine analyses its own channel
+     * - maxMagnitude: one complex FFT of L + iR; peaks are picked per bin on the
+     *                 louder channel, and each channel's oscillators are scaled by
+     *                 that channel's magnitude at the partial's bin
+     * - mid:          as maxMagnitude, but peaks are picked on the mid (L + R) / 2
+     */
+    enum class ChannelLink
+    {
+        independent,
+        maxMagnitude,
+        mid
+    };
+
+    /**
+     * How the partials are turned back into audio
+     *
+     * - oscillatorBank: one time-domain oscillator per voice (cost grows with VOICES)
+     * - inverseFFT:     windowed kernels summed into one spectrum per hop, one inverse
+     *                   FFT and overlap-add (InverseFFTSynthesiser - cost almost flat
+     *                   in the number of partials, one hop of extra latency)
+     */
+    enum class SynthesisBackend
+    {
+        oscillatorBank,
+        inverseFFT
+    };
+
+    /**
+     * Share of the per-stage budget used by an amortised stage
+     * (1.0 = the stage took as long as hopSize / numAnalysisStages samples of audio)
+     */
+    struct StageLoad
+    {
+        float last = 0.0f;
+        float peak = 0.0f;
+    };
+
     SolaireEngine();
+    ~SolaireEngine();
+
+    /** Select the analysis mode - takes effect at the next prepareToPlay() */
+    void setAnalysisMode(AnalysisMode newMode) { requestedAnalysisMode.store(newMode); }
+    AnalysisMode getAnalysisMode() const { return analysisMode; }
+
+    /**
+     * Link a follower engine to this one's analysis - takes effect at the next prepareToPlay()
+     *
+     * Both engines must be prepared with the same sample rate and driven together
+     * through processLinkedBlock(). The follower never analyses on its own.
+     */
+    void setChannelLink(ChannelLink newLink, SolaireEngine* follower)
+    {
+        requestedChannelLink.store(follower != nullptr ? newLink : ChannelLink::independent);
+        requestedLinkedFollower.store(follower);
+    }
+
+    /** Channel link applied at the last prepareToPlay() */
+    ChannelLink getChannelLink() const { return channelLink; }
+
+    /**
+     * Multi-resolution analysis - takes effect at the next prepareToPlay()
+     *
+     * 1 = one window per frame (default). 2-4 = octave bands: band 0 is the SLICE
+     * window at full rate, and each lower band transforms the same FFT size on the
+     * input decimated by a further 2 - a window twice as long, with twice the
+     * frequency resolution, analysed every 2^band hops. Band k keeps the peaks
+     * between 0.2 and 0.4 of its own rate (band 0 up to Nyquist, the last band down
+     * to DC) and the bands' peaks are merged into one set for the tracker.
+     *
+     * Linked stereo pairs always analyse one band (their frame is shared), and the
+     * longest SLICE orders have fewer decimated levels left for extra bands.
+     */
+    void setAnalysisBands(int numBands) { requestedAnalysisBands.store(juce::jlimit(1, maxAnalysisBands, numBands)); }
+
+    /** Bands applied at the last prepareToPlay() */
+    int getAnalysisBands() const { return analysisBands; }
+
+    /** Select the synthesis backend - takes effect at the next prepareToPlay() */
+    void setSynthesisBackend(SynthesisBackend newBackend) { requestedSynthesisBackend.store(newBackend); }
+    SynthesisBackend getSynthesisBackend() const { return synthesisBackend; }
+
+    static constexpr int maxAnalysisBands = 4;
+
+    /**
+     * Snapshot bank for captureSnapshot()/recallSnapshot() - takes effect at the next
+     * prepareToPlay() (nullptr = snapshots off). The caller owns the bank, so its
+     * snapshots outlive the engine; a linked pair uses the leader's bank, and each
+     * of its snapshots holds both channels.
+     */
+    void setSnapshotBank(SnapshotBank* bank) { requestedSnapshotBank.store(bank); }
+
+    /**
+     * Editor feed (applied at the next prepareToPlay(); nullptr = none): while a
+     * reader is attached, the analysed spectrum and the partials given to the
+     * oscillators are published at TelemetryFeed::publishRateHz. Without a reader
+     * each frame costs one relaxed load. The caller owns the feed.
+     */
+    void setTelemetryFeed(TelemetryFeed* feed) { requestedTelemetryFeed.store(feed); }
+
+    /**
+     * Store the partial set being played (after the spectral modifiers) into a bank
+     * slot - done by the audio thread at the next oscillator update (any thread)
+     */
+    void captureSnapshot(int slot)
+    {
+        if (slot >= 0 && slot < SnapshotBank::numSlots)
+            pendingSnapshotCapture.store(slot);
+    }
+
+    /**
+     * Play a stored snapshot instead of the analysed partials, from the start of the
+     * next block (any thread). Nothing is re-analysed: the decoded set simply becomes
+     * the oscillator targets, while analysis keeps running underneath so that
+     * releaseSnapshot() hands back to the live partials at the next frame. Recalling
+     * an empty slot is ignored.
+     */
+    void recallSnapshot(int slot)
+    {
+        if (slot >= 0 && slot < SnapshotBank::numSlots)
+            pendingSnapshotRecall.store(slot);
+    }
+
+    void releaseSnapshot() { pendingSnapshotRecall.store(releaseSnapshotRequest); }
+
+    /** Slot being played instead of the analysed partials, or -1 (any thread) */
+    int getRecalledSnapshot() const { return recalledSnapshotSlot.load(); }
 
     void prepareToPlay(double sampleRate, int samplesPerBlock);
     void releaseResources();
 
-    /** Process a single sample (uses internal FIFOs and overlap-add) */
+    /**
+     * Process a block of samples (input and output may point to the same buffer)
+     *
+     * Takes processingLock once per block and splits the block at hop boundaries,
+     * so processFrame() runs between contiguous sub-blocks that are handed to the
+     * oscillator bank and output effects in one go.
+     */
+    void processBlock(const float* input, float* output, int numSamples);
+
+    /**
+     * Process a linked stereo block: this engine renders the left channel, the
+     * follower the right, with one shared analysis at every hop boundary
+     * (buffers may be processed in place)
+     */
+    void processLinkedBlock(const float* inputLeft, const float* inputRight,
+                            float* outputLeft, float* outputRight, int numSamples);
+
+    /** Process a single sample (compatibility wrapper around processBlock) */
     float processSample(float inputSample);
 
     /** Parameter setters (0.0 to 1.0 range) */
     void setSlice(float value);         // PHASE 4: FFT window size (17ms - 6400ms)
-    void setVoice(float value);         // PHASE 4: Active oscillator count (1-33)
+    void setFFTOrder(int order);        // Direct window order (7-19), bypassing the SLICE ms mapping
+    void setVoice(float value);         // PHASE 4: Active oscillator count (1-maxVoices)
     void setFreeze(float value);        // PHASE 4: Spectral freeze on/off
     void setBlur(float value);          // PHASE 5: Spectral smoothing (EMA alpha)
     void setWarp(float value);          // PHASE 5: Frequency warp
@@ -50,26 +280,188 @@ public:
     void setGlide(float value);         // Portamento/glide time (0 - 1000ms)
     void setWaveform(float value);      // Waveform selection (0-1 maps to 0-3 index)
 
-    // Output effects (COLOR and FLOAT kept per user request)
+    // Output effects (COLOR kept per user request; FLOAT is the processor's FloatReverb)
     void setMix(float value);           // Dry/Wet blend
     void setColour(float value);        // Tilt EQ balance (complementary shelving)
-    void setFloat(float value);         // Reverb decay time
 
-    int getLatencyInSamples() const { return fftSize; }
+    /** Normalised (0.0 to 1.0) value of every parameter, as the setters above take them */
+    struct Parameters
+    {
+        float slice = 0.1f;
+        float voice = 1.0f;
+        float freeze = 0.0f;
+        float blur = 0.0f;
+        float warp = 0.5f;
+        float feedback = 0.0f;
+        float centerFreq = 0.5f;
+        float bandwidth = 1.0f;
+        float freq = 0.5f;
+        float octave = 0.5f;
+        float glide = 0.01f;
+        float waveform = 0.0f;
+        float mix = 0.5f;
+        float colour = 0.5f;
+    };
+
+    /**
+     * One block of parameters as linear ramps: start holds at the block's first
+     * sample, end after its last (plain data, copied by value)
+     */
+    struct ParameterBlock
+    {
+        Parameters start;
+        Parameters end;
+    };
+
+    /**
+     * Publish the parameters of the next processBlock()/processLinkedBlock() call
+     * (audio thread, right before the call; values must already be in 0.0 to 1.0).
+     *
+     * MIX ramps per sample, COLOR every 32 samples while it moves, and everything
+     * read once per frame (SLICE, VOICE, FREEZE, modifiers, frequency window, glide,
+     * waveform) takes its value at the hop boundary. The pow/log mappings only rerun when
+     * their inputs move. Published values stay in force until the next call, or
+     * until one of the setters above is used again.
+     */
+    void setParameters(const ParameterBlock& newParameters);
+
+    /**
+     * Constant latency of the engine: the largest analysis window, plus its hop when
+     * results are applied after the frame (async/amortised) and the synthesis hop of
+     * the inverseFFT backend. Set in prepareToPlay();
+     * TIME changes only move an internal wet-path delay, never this value.
+     */
+    int getLatencyInSamples() const { return latencySamples; }
+
+    /** Budget usage of an amortised analysis stage (safe to call from any thread) */
+    StageLoad getAnalysisStageLoad(AnalysisStage stage) const
+    {
+        const auto index = static_cast<size_t>(stage);
+        return { stageLoadLast[index].load(), stageLoadPeak[index].load() };
+    }
+
+    /** Clear the peak values reported by getAnalysisStageLoad() */
+    void resetAnalysisStageLoad()
+    {
+        for (auto& peak : stageLoadPeak)
+            peak.store(0.0f);
+    }
+
+    /**
+     * Opt-in quality governor (any thread, effective from the next block): a block
+     * that takes longer than budgetFraction of its duration steps processing down
+     * one tier - fewer voices, then half the analysis overlap, then no BLUR and
+     * FEEDBACK - and tiers come back with hysteresis (see QualityGovernor.h).
+     * Latency and the wet/dry alignment are the same in every tier.
+     */
+    void setQualityGovernor(bool enabled, double budgetFraction = 0.5) { governor.setEnabled(enabled, budgetFraction); }
+
+    /** Current quality tier and last block's share of its budget (any thread, e.g. a meter) */
+    QualityGovernor::Tier getQualityTier() const { return governor.getTier(); }
+    float getGovernorLoad() const { return governor.getLoad(); }
+
+    /**
+     * Sleep mode (any thread, on by default): once the input has stayed below
+     * sleepThreshold for the latency plus a hop, no voice is sounding and the wet
+     * output (after COLOR) has decayed below it too, the engine stops analysing and
+     * synthesising and only delays the dry path through MIX. The first block with an
+     * input sample above the threshold (or a snapshot recall) wakes it, on the same
+     * hop grid and with silent wet lines, so waking cannot click.
+     */
+    void setSleepEnabled(bool shouldSleep) { sleepEnabled.store(shouldSleep); }
+    bool isSleeping() const { return sleeping.load(std::memory_order_relaxed); }
+
+    static constexpr float sleepThreshold = 1.0e-6f;  // -120 dBFS
+
+    /**
+     * How long the output keeps sounding after the input stops (for the host's
+     * AudioProcessor::getTailLengthSeconds()): the latency, the tracker's hold and
+     * the voices' release and glide (the FLOAT reverb adds its own decay, see
+     * FloatReverb::getTailLengthSeconds()). Static so the processor can answer from
+     * any thread without the engines.
+     */
+    static double getTailLengthSeconds(double rate, int latency, float glideSeconds);
+
+    /** Frames skipped because the analysis thread fell behind (asynchronous mode) */
+    int getNumDroppedAnalysisFrames() const { return droppedAnalysisFrames.load(); }
+
+    /**
+     * Per-stage timing counters (lock-free, safe to call from any thread)
+     *
+     * Only collected in builds with SOLAIRE_ENABLE_PROFILING=1; otherwise the
+     * snapshot is empty (enabled = false) and the timers compile to nothing.
+     */
+    StageProfiler::Snapshot getProfileSnapshot() const
+    {
+       #if SOLAIRE_ENABLE_PROFILING
+        return profiler.getSnapshot();
+       #else
+        return {};
+       #endif
+    }
+
+    /** Clear the profiling counters and set the xrun budget (fraction of the block duration) */
+    void resetProfile(double blockBudgetFraction = 1.0)
+    {
+       #if SOLAIRE_ENABLE_PROFILING
+        profiler.setBlockBudgetFraction(blockBudgetFraction);
+        profiler.reset();
+       #else
+        juce::ignoreUnused(blockBudgetFraction);
+       #endif
+    }
+
+    /** Window order range accepted by setFFTOrder() (the window is 2^order input samples) */
+    static constexpr int minFFTOrder = 7;                   // 2^7 = 128 samples
+    static constexpr int maxFFTOrder = 19;                  // 2^19 = 524288 samples (6400 ms up to 96 kHz)
+
+    /** Largest FFT actually computed - longer windows analyse a decimated signal */
+    static constexpr int maxTransformOrder = 14;            // 2^14 = 16384 points
+
+    /** Memory owned by one engine instance (see getMemoryFootprint()) */
+    struct MemoryFootprint
+    {
+        size_t allocatedBytes = 0;          // Object + buffers + FFT plans + window tables
+        size_t frameWorkingSetBytes = 0;    // Memory one analysis frame touches at the current order
+    };
+
+    /**
+     * Memory footprint at the current order (message thread; plan sizes come from
+     * FFTBackend::getMemoryBytes(), estimated where the library does not report them)
+     */
+    MemoryFootprint getMemoryFootprint() const;
 
 private:
     // PHASE 4: Dynamic FFT configuration (SLICE parameter)
-    // SOURCE: JUCE forum (forum.juce.com/t/29348) - IvanC: "Use unique_ptr and reset to change size"
-    // SOURCE: JUCE dsp::Convolution - thread-safe FFT size changing pattern
+    // FFT plans for every transform order are built in prepareToPlay; a SLICE change
+    // only switches between them at the next hop (no allocation on the audio thread).
+    // Orders above maxTransformOrder reuse the largest plan on a decimated history.
+    static constexpr int numTransformOrders = maxTransformOrder - minFFTOrder + 1;
+    static constexpr int maxTransformSize = 1 << maxTransformOrder;
+    static constexpr int maxNumBins = maxTransformSize / 2 + 1;
+    static_assert(maxFFTOrder - maxTransformOrder <= DecimatedHistory::numLevels
+                      && DecimatedHistory::ringSize == maxTransformSize,
+                  "Every order above the largest FFT needs a decimated history level");
+
     int fftOrder = 10;                                      // 2^10 = 1024 (default)
-    int fftSize = 1 << fftOrder;                            // 1024 samples (updated dynamically)
-    int numBins = fftSize / 2 + 1;                          // 513 bins (updated dynamically)
-    static constexpr int overlap = 4;                       // 75% overlap (constant)
-    int hopSize = fftSize / overlap;                        // 256 samples (updated dynamically)
+    int fftSize = 1 << fftOrder;                            // Window length in input samples (updated at hop boundaries)
+    int transformSize = fftSize;                            // FFT points: min(fftSize, maxTransformSize)
+    int decimationLevel = 0;                                // Analysis runs at sampleRate / 2^decimationLevel
+    static constexpr int overlap = 4;                       // 75% overlap of the transform frame (constant)
+    int hopSize = fftSize / overlap;                        // 256 samples (updated at hop boundaries)
     static constexpr float windowCorrection = 2.0f / 3.0f;  // Hann^2 with 75% overlap
 
+    // Requested FFT order from setSlice(), picked up by the audio thread at the next hop
+    std::atomic<int> pendingFFTOrder{10};
+
+    // Partial-domain crossfade after a SLICE change (in analysis frames)
+    static constexpr int sliceCrossfadeFrames = 2;
+    int sliceCrossfadeRemaining = 0;
+
     // Panharmonium spectral resynthesis constants
-    static constexpr int maxSpectralPeaks = 33;             // Rossum Panharmonium: 33 oscillators
+    using PartialTracker = BasicPartialTrackingEngine<maxVoices>;
+    static constexpr int maxSpectralPeaks = PartialTracker::MAX_TRACKS;  // Rossum Panharmonium: 33 oscillators
+    using TrackSlots = PartialTracker::TrackSlots;   // Slot i drives oscillator voice i
 
     // PHASE 4: SLICE parameter range (Rossum Panharmonium specification)
     // SOURCE: Rossum Panharmonium manual - 17ms to 6400ms window sizes
@@ -77,58 +469,122 @@ private:
     static constexpr float MAX_SLICE_MS = 6400.0f;
 
     //==========================================================================
-    // Core FFT objects
-    std::unique_ptr<juce::dsp::FFT> fft;
-    std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
-
-    // PHASE 4: Dynamic buffers for variable FFT size (SLICE parameter)
-    // SOURCE: JUCE forum pattern - use std::vector for runtime-resizable buffers
-    // Circular FIFOs for overlap-add (audiodev.blog pattern)
-    std::vector<float> inputFifo;
-    std::vector<float> outputFifo;
+    // Core FFT objects: one plan and Hann table per transform order, built in prepareToPlay
+    // SOURCE: juce::dsp::FFT / WindowingFunction - construct once, reuse per frame
+    // (the plan is the build's FFTBackend; the tables are JUCE's periodic Hann values,
+    // kept here so the window is applied while copying the frame out of the ring)
+    std::array<std::unique_ptr<FFTBackend>, numTransformOrders> fftPlans;
+    std::array<std::vector<float>, numTransformOrders> windowTables;
+    FFTBackend* fft = nullptr;                              // Plan for the current order
+    const float* windowTable = nullptr;                     // Hann table for the current order
+
+    // Buffers sized for maxTransformSize so SLICE changes never resize them
     std::vector<float> fftData;  // Interleaved complex numbers
 
-    int fifoPos = 0;    // Current position in circular buffer
     int hopCount = 0;   // Counter for hop size
 
-    //==========================================================================
-    // Spectral processing state (dynamic for variable FFT size)
-    std::vector<float> prevMagnitude;      // For BLUR (EMA smoothing)
-    std::vector<float> prevPhase;          // For WARP (phase vocoder)
-    std::vector<float> feedbackMagnitude;  // For FEEDBACK
+    // Input at 1/2 ... 1/32 rate for windows longer than maxTransformSize (and lower
+    // multi-resolution bands). Only fed while the current order reads it: the default
+    // TIME and sleeping engines skip the cascade
+    DecimatedHistory decimatedHistory;
+    bool decimatedHistoryActive = false;                    // Audio thread
 
     // Spectral peak extraction (Phase 1: Panharmonium resynthesis)
     // SOURCE: audiodev.blog FFT tutorial + DSPRelated peak detection
-    std::vector<SpectralPeak> currentPeaks;        // Extracted peaks from current frame
+    std::array<SpectralPeak, maxSpectralPeaks> currentPeaks;  // Extracted peaks from current frame
+    int numCurrentPeaks = 0;
+    std::vector<float> peakPowerScratch;           // Squared magnitudes (2 * maxNumBins)
+
+    // Multi-resolution analysis: the latest peaks of every band (a lower band is only
+    // re-analysed every 2^band frames), merged strongest-first into currentPeaks
+    std::array<std::array<SpectralPeak, maxSpectralPeaks>, maxAnalysisBands> bandPeaks;
+    std::array<int, maxAnalysisBands> numBandPeaks{};
+    std::array<SpectralPeak, maxSpectralPeaks * maxAnalysisBands> mergedPeakScratch;
 
     // Partial tracking (Phase 2: Panharmonium resynthesis)
     // SOURCE: McAulay-Quatieri algorithm + JUCE forums
-    PartialTrackingEngine partialTracker;          // Maintains peak identity across frames
+    PartialTracker partialTracker;                 // Maintains peak identity across frames
 
     // Oscillator bank (Phase 3: Panharmonium resynthesis)
     // SOURCE: JUCE DSP Tutorial + JUCE forums
-    OscillatorBank oscillatorBank;                 // 33 independent sine oscillators
+    // One bank per voice capacity; the smallest that holds VOICE plays, chosen at the
+    // block boundary (voices carry over, so a switch is inaudible)
+    BasicOscillatorBank<8> oscillatorBank8;
+    BasicOscillatorBank<16> oscillatorBank16;
+    BasicOscillatorBank<maxVoices> oscillatorBank; // 33 independent sine oscillators (or maxVoices)
+    int oscillatorBankCapacity = maxVoices;
+
+    // Call function with the bank of the given capacity (8, 16 or maxVoices)
+    template <typename Function>
+    void withOscillatorBank(int capacity, Function&& function)
+    {
+        if (capacity == decltype(oscillatorBank8)::NUM_VOICES)
+            function(oscillatorBank8);
+        else if (capacity == decltype(oscillatorBank16)::NUM_VOICES)
+            function(oscillatorBank16);
+        else
+            function(oscillatorBank);
+    }
+
+    template <typename Function>
+    void withOscillatorBank(Function&& function) { withOscillatorBank(oscillatorBankCapacity, function); }
+
+    // Inverse-FFT backend (setSynthesisBackend) - only prepared while it is selected
+    InverseFFTSynthesiser inverseSynthesiser;
+    std::atomic<SynthesisBackend> requestedSynthesisBackend{SynthesisBackend::oscillatorBank};
+    SynthesisBackend synthesisBackend = SynthesisBackend::oscillatorBank;
+
+    // Call function with whatever renders the partials: the IFFT synthesiser or the active bank
+    template <typename Function>
+    void withSynthesiser(Function&& function)
+    {
+        if (synthesisBackend == SynthesisBackend::inverseFFT)
+            function(inverseSynthesiser);
+        else
+            withOscillatorBank(function);
+    }
 
     // PHASE 5: Spectral modifier state (per-partial tracking)
     // SOURCE: Adapted from verified FFT bin processing patterns
-    std::unordered_map<int, float> prevPartialAmplitudes;  // For BLUR (trackID → amplitude)
-    std::unordered_map<int, float> feedbackAmplitudes;     // For FEEDBACK (trackID → amplitude)
+    // Indexed by tracker slot; a slot's state is cleared when a new track takes it over
+    std::array<int, maxVoices> modifierTrackIDs;     // trackID owning each slot's state
+    std::array<float, maxVoices> prevPartialAmplitudes;  // For BLUR
+    std::array<float, maxVoices> feedbackAmplitudes;     // For FEEDBACK
 
     //==========================================================================
     // Output effects (juce::dsp patterns)
-    juce::Reverb reverb;
     juce::dsp::IIR::Filter<float> lowShelf;
     juce::dsp::IIR::Filter<float> highShelf;
+    float appliedColour = -1.0f;                       // Colour the shelf coefficients were designed for
+    static constexpr float colourUpdateThreshold = 0.002f;  // Shelf gain step below 0.04 dB
+    static constexpr int colourChunkSize = 32;              // Samples per coefficient update while COLOR ramps
 
-    // Dry buffer for mix (dynamic for variable FFT size)
-    std::vector<float> dryBuffer;
-    int dryBufferPos = 0;
+    //==========================================================================
+    // One shared input ring: every analysis frame reads its newest samples and the
+    // dry path reads it delayed by the constant latency (no separate FIFO copies).
+    // The wet path is delayed by what the current window lacks of that latency, so
+    // MIX blends time-aligned signals (both rings share delayWritePos)
+    static constexpr int delayLineSize = 32768;             // Power of 2 >= max latency + max sub-block
+    static constexpr int delayLineMask = delayLineSize - 1;
+    static constexpr int wetDelayCrossfadeSamples = 1024;   // Fade between taps when TIME changes
+    static_assert(delayLineSize >= maxTransformSize + 2 * (maxTransformSize / overlap)
+                                       + InverseFFTSynthesiser::maxHopSize,
+                  "Delay lines must hold the latency plus one hop-sized sub-block");
+
+    std::vector<float> inputHistory;                        // Full-rate input (frames + dry path), mirrored
+    std::vector<float> wetDelayLine;
+    std::vector<float> delayedDry;                          // Dry samples of the current sub-block
+    int delayWritePos = 0;
+    int latencySamples = maxTransformSize;
+    int wetDelaySamples = 0;
+    int previousWetDelaySamples = 0;                        // Tap faded out after a TIME change
+    int wetCrossfadeRemaining = 0;
 
     //==========================================================================
     // Parameters (atomic for thread-safe parameter changes)
     // PHASE 4: Core Panharmonium parameters
     std::atomic<float> currentSlice{0.1f};         // FFT window size (17ms - 6400ms, log scale)
-    std::atomic<float> currentVoice{1.0f};         // Active oscillator count (1-33)
+    std::atomic<float> currentVoice{1.0f};         // Active oscillator count (getVoiceCount)
     std::atomic<float> currentFreeze{0.0f};        // Spectral freeze (0=off, 1=on)
 
     // PHASE 5: Spectral modifiers
@@ -146,10 +602,40 @@ private:
     std::atomic<float> currentGlide{0.01f};        // Glide time in seconds (0 - 1.0s)
     std::atomic<float> currentWaveform{0.0f};      // Waveform index (0-1 maps to 0-3)
 
-    // Output effects (PHASE 8: COLOR and FLOAT kept, RESONANCE removed)
+    // Output effects (PHASE 8: COLOR kept, RESONANCE removed; FLOAT moved to FloatReverb)
     std::atomic<float> currentMix{0.5f};
     std::atomic<float> currentColour{0.5f};        // 0.5 = flat (tilt EQ)
-    std::atomic<float> currentFloat{0.0f};         // Reverb amount
+
+    // Bumped by every setter, so a block only reloads the atomics after one was used
+    std::atomic<juce::uint32> setterGeneration{0};
+
+    //==========================================================================
+    // Block parameters (audio thread only): the published ramps or the setters' values
+    ParameterBlock blockParameters;
+    bool parametersPublished = false;               // setParameters() ran for the coming block
+    juce::uint32 appliedSetterGeneration = 0;
+    float mappedSlice = -1.0f;                      // Published SLICE the pending order was derived from
+    int blockLength = 1;                            // Samples in the current block
+    int blockPosition = 0;                          // Samples of it rendered so far
+
+    // Spectral settings of one frame, mapped once per hop from the parameters at the
+    // hop boundary (asynchronous frames carry their copy to the analysis thread)
+    struct FrameSettings
+    {
+        bool frozen = false;
+        float blur = 0.0f;
+        float feedback = 0.0f;
+        bool warpActive = false;
+        float warpRatio = 1.0f;
+        float pitchRatio = 1.0f;                    // FREQ cents x OCTAVE transposition
+        float minFrequency = 0.0f;                  // CENTER_FREQ + BANDWIDTH window
+        float maxFrequency = 0.0f;
+        bool publishSpectrum = false;               // Telemetry due (not part of the mapping)
+    };
+
+    FrameSettings frameSettings;                    // Synchronous/amortised frame (and the mapping cache)
+    Parameters frameSettingsSource;                 // Inputs frameSettings was mapped from
+    bool frameSettingsMapped = false;
 
     double sampleRate = 44100.0;
 
@@ -157,20 +643,238 @@ private:
     // Thread safety (critical - see juce_critical_knowledge.md)
     juce::SpinLock processingLock;
 
+    //==========================================================================
+    // Asynchronous analysis (SPSC queues between audio thread and analysis thread)
+    // SOURCE: juce::AbstractFifo - lock-free single-producer/single-consumer indices
+    // In asynchronous mode the tracker, peaks and modifier state belong to the
+    // analysis thread; the audio thread only windows frames and applies results.
+    // Partial set of one analysis frame (working copy of the tracker slots), plus the
+    // per-channel amplitude gain of every slot when the stereo pair is linked
+    struct PartialFrame
+    {
+        TrackSlots tracks;
+        std::array<std::array<float, maxVoices>, 2> channelGains{};
+    };
+
+    // Lower octave bands of one frame (multi-resolution analysis): band k is the
+    // frame's FFT size on the input decimated by a further 2^k
+    struct BandFrames
+    {
+        std::array<std::vector<float>, maxAnalysisBands - 1> data;  // Bands 1 .. numBands - 1 (2 * maxTransformSize)
+        int numBands = 1;            // Bands analysed at this frame's order (band 0 = the main frame)
+        int windowedMask = 0;        // Bit k set: band k was windowed into data[k - 1] for this frame
+    };
+
+    struct AnalysisFrame
+    {
+        std::vector<float> data;     // Windowed input, transformed in place (2 * maxTransformSize)
+                                     // Linked: interleaved L + iR, replaced by the combined spectrum
+        BandFrames bands;
+        FrameSettings settings;
+        int fftOrder = 10;
+        bool sliceChanged = false;
+    };
+
+    class AnalysisThread : public juce::Thread
+    {
+    public:
+        explicit AnalysisThread(SolaireEngine& ownerEngine)
+            : juce::Thread("Solaire Analysis"), engine(ownerEngine) {}
+
+        void run() override
+        {
+            while (!threadShouldExit())
+            {
+                engine.processPendingAnalysis();
+
+                // Polled, never signalled: notify() would take the event's mutex on the
+                // audio thread. The frame FIFO's ready count is the lock-free "frame
+                // ready" flag; only stopThread() ends this wait early.
+                wait(pollIntervalMs);
+            }
+        }
+
+    private:
+        // Well under the hop at the default TIME (256 samples); at the shortest
+        // hops one poll drains every queued frame, and frames beyond the queue are
+        // dropped exactly as when analysis falls behind
+        static constexpr int pollIntervalMs = 1;
+
+        SolaireEngine& engine;
+    };
+
+    static constexpr int analysisQueueSize = 4;     // AbstractFifo holds size - 1 items
+
+    std::atomic<AnalysisMode> requestedAnalysisMode{AnalysisMode::synchronous};
+    AnalysisMode analysisMode = AnalysisMode::synchronous;
+
+    std::array<AnalysisFrame, analysisQueueSize> analysisFrames;
+    std::array<PartialFrame, analysisQueueSize> analysisResults;
+    juce::AbstractFifo analysisFrameFifo{analysisQueueSize};
+    juce::AbstractFifo analysisResultFifo{analysisQueueSize};
+    std::unique_ptr<AnalysisThread> analysisThread;
+    std::atomic<int> droppedAnalysisFrames{0};
+    bool pendingSliceChange = false;                // Audio thread: flag for the next pushed frame
+
+    // Partial set produced by the synchronous and amortised paths
+    PartialFrame framePartials;
+    BandFrames frameBands;                          // Lower bands of the synchronous/amortised frame
+
+    // Multi-resolution analysis settings (fixed between prepareToPlay() calls)
+    std::atomic<int> requestedAnalysisBands{1};
+    int analysisBands = 1;
+    int bandFrameCounter = 0;                       // Audio thread: band k is windowed when counter % 2^k == 0
+
+    // FREEZE state captured at peak picking, so the tracking stage of the same frame agrees
+    bool frameFrozen = false;
+
+    //==========================================================================
+    // Spectral snapshots: requests are picked up by the audio thread (capture at the
+    // next oscillator update, recall at the next block start)
+    static constexpr int noSnapshotRequest = -2;
+    static constexpr int releaseSnapshotRequest = -1;
+
+    std::atomic<SnapshotBank*> requestedSnapshotBank{nullptr};
+    SnapshotBank* snapshotBank = nullptr;   // Fixed between prepareToPlay() calls
+    std::atomic<int> pendingSnapshotCapture{noSnapshotRequest};
+    std::atomic<int> pendingSnapshotRecall{noSnapshotRequest};
+    std::atomic<int> recalledSnapshotSlot{-1};      // Written by the audio thread only
+    PartialFrame recalledPartials;                  // Audio thread: the decoded snapshot
+
+    //==========================================================================
+    // Editor telemetry (setTelemetryFeed): throttled on the audio thread per frame
+    std::atomic<TelemetryFeed*> requestedTelemetryFeed{nullptr};
+    TelemetryFeed* telemetryFeed = nullptr;         // Fixed between prepareToPlay() calls
+    int telemetryInterval = 1470;                   // Samples between publications
+    int telemetrySamples = 0;                       // Audio thread: samples since the last one
+    bool partialTelemetryDue = false;               // Audio thread: publish at the next oscillator update
+    juce::uint32 spectrumTelemetrySequence = 0;     // Thread that analyses
+    juce::uint32 partialTelemetrySequence = 0;      // Audio thread
+
+    //==========================================================================
+    // Linked stereo analysis (leader side; fixed between prepareToPlay() calls)
+    std::atomic<ChannelLink> requestedChannelLink{ChannelLink::independent};
+    std::atomic<SolaireEngine*> requestedLinkedFollower{nullptr};
+    ChannelLink channelLink = ChannelLink::independent;
+    SolaireEngine* linkedFollower = nullptr;        // Non-null only while linked
+
+    std::vector<float> linkedSpectrum;              // Analysis: complex FFT of L + iR (2 * maxTransformSize)
+    std::array<std::vector<float>, 2> linkedChannelPower;  // Analysis: |X_L|^2, |X_R|^2 per bin
+    std::array<std::array<float, maxVoices>, 2> trackerChannelGains{};
+    int analysedFrameSize = 1024;                   // Analysis: FFT size of the frame being tracked
+    double analysedSampleRate = 44100.0;            // Analysis: sample rate of that frame (decimated)
+
+    //==========================================================================
+    // Amortised analysis (stages spread across the hop on the audio thread)
+    int nextAnalysisStage = numAnalysisStages;      // numAnalysisStages = frame complete
+    int amortisedFrameOrder = 10;
+    bool amortisedSliceChanged = false;
+    std::array<std::atomic<float>, numAnalysisStages> stageLoadLast{};
+    std::array<std::atomic<float>, numAnalysisStages> stageLoadPeak{};
+
+    //==========================================================================
+    // Quality governor (times every block while enabled; tiers read where they apply)
+    QualityGovernor governor;
+    bool skipNextFrame = false;                     // Reduced overlap: every second hop starts no frame
+
+    //==========================================================================
+    // Sleep mode (setSleepEnabled): silent instances only run the dry path
+    std::atomic<bool> sleepEnabled{true};
+    std::atomic<bool> sleeping{false};              // Written by the audio thread only
+    int quietSamples = 0;                           // Samples since the output last had to be rendered
+    float wetPeak = 0.0f;                           // Largest wet sample after COLOR in this block
+
+   #if SOLAIRE_ENABLE_PROFILING
+    // Per-stage timers (SOLAIRE_PROFILE_STAGE / SOLAIRE_PROFILE_BLOCK in the .cpp)
+    StageProfiler profiler;
+   #endif
+
     //==========================================================================
     // Private methods
     void reset();
     void processFrame();
-    void spectralManipulation(float* fftDataBuffer);
-    void applyOutputEffects(float& sample);
-
-    // PHASE 4: Dynamic FFT size management (SLICE parameter)
-    // SOURCE: JUCE dsp::Convolution pattern - thread-safe FFT reset
-    void updateFFTSize(int newOrder);
+    void skipFrame();
+    void copyWindowedFrame(float* destination, BandFrames& bands);
+    const float* getNewestFrame(const SolaireEngine& source, int level) const;
+    void copyWindowedChannel(const SolaireEngine& source, float* destination, int level) const;
+    void windowBandFrames(BandFrames& bands);
+    void analyseFrame(float* frameData, BandFrames& bands, int order, bool sliceChanged,
+                      const FrameSettings& settings, PartialFrame& partials);
+    void updateOscillators(const PartialFrame& analysedPartials);
+    void scheduleTelemetry();
+    void publishSpectrumTelemetry(const float* spectrum, int order);
+    void publishPartialTelemetry(const TrackSlots& tracks, int voiceLimit);
+    void applySnapshotRequests();
+    void captureSnapshotFrom(const PartialFrame& partials);
+
+    // Block processing steps (processBlock() and processLinkedBlock() share them)
+    void beginBlock(int numSamples);
+    int getBlockVoiceLimit() const;
+    void selectOscillatorBank(int voiceLimit);
+    int getNextSubBlockSize(int numSamplesLeft) const;
+    void renderSubBlock(const float* input, float* output, int numSamples);
+    void advanceAnalysis(int numSamples);
+
+    // Sleep mode steps (the pair's leader decides for both channels)
+    bool isSynthesisSilent();
+    bool continueSleeping(bool quiet);
+    void updateSleepState(bool quiet, int numSamples);
+    void enterSleep();
+    void sleepSubBlock(const float* input, float* output, int numSamples);
+    void advanceSleepingHop(int numSamples);
+
+    // Analysis stages (analyseFrame() runs them back to back)
+    void transformFrame(float* frameData, BandFrames& bands, int order);
+    void splitLinkedSpectrum(float* frameData, int size);
+    void extractFramePeaks(const float* spectrum, const BandFrames& bands, int order, const FrameSettings& settings);
+    int extractBandPeaks(const float* spectrum, int order, int band, int numBands, SpectralPeak* peaks);
+    void mergeBandPeaks(int numBands);
+    void trackFramePeaks(PartialFrame& partials);
+    void modifyFrameTracks(TrackSlots& tracks, const FrameSettings& settings, bool sliceChanged);
+
+    // Amortised analysis helpers
+    int getStageOffset(int stage) const { return (stage * hopSize) / numAnalysisStages; }
+    void runAnalysisStage(int stage);
+
+    // Asynchronous analysis helpers
+    void pushAnalysisFrame();
+    void applyLatestAnalysisResult();
+    void processPendingAnalysis();       // Analysis thread only
+    void stopAnalysisThread();
+    // Latency alignment helpers (audio thread, allocation-free)
+    int getWetPathLatency() const;
+    void updateWetDelay();
+    void setWetDelay(int newDelay);
+    void matchLinkedLatency(const SolaireEngine& leader);
+    void writeDelayLine(std::vector<float>& line, const float* source, int numSamples) const;
+    void readDelayLine(const std::vector<float>& line, int delay, float* destination, int numSamples) const;
+    void delayWetSamples(float* samples, int numSamples);
+    void updateColourCoefficients(float colour);  // Allocation-free, in place
+    void applyOutputEffects(float* samples, const float* drySamples, int numSamples);
+    void applyMix(float* samples, const float* drySamples, int numSamples) const;
+
+    // Parameter helpers (setters from any thread, the rest audio thread only)
+    void storeParameter(std::atomic<float>& parameter, float value);
+    Parameters loadSetterParameters() const;
+    Parameters getParametersAt(int position) const;
+    float getParameterAt(float Parameters::* parameter, int position) const;
+    int getOrderForSlice(float slice) const;
+    void updateFrameSettings();
+
+    // PHASE 4: FFT size management (SLICE parameter)
+    // prepareFFTPlans() allocates (prepareToPlay only); selectFFTOrder() is allocation-free
+    void prepareFFTPlans();
+    void selectFFTOrder(int newOrder);
+    static int getTransformOrder(int order) { return std::min(order, maxTransformOrder); }
+    static int getDecimationLevel(int order) { return std::max(0, order - maxTransformOrder); }
+    int getActiveBands(int order) const { return std::min(analysisBands, DecimatedHistory::numLevels - getDecimationLevel(order) + 1); }
+    bool needsDecimatedHistory(int order) const { return getDecimationLevel(order) > 0 || getActiveBands(order) > 1; }
+    void updateDecimatedHistory(bool refill);
+    void applySliceCrossfade(TrackSlots& tracks);
 
     // PHASE 5: Spectral modifier application to partial tracks
     // SOURCE: Adapted from verified FFT bin processing patterns
-    void applySpectralModifiers(std::vector<PartialTrack>& tracks);
+    void applySpectralModifiers(TrackSlots& tracks, const FrameSettings& settings);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SolaireEngine)
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
 #include <vector>
 #include <complex>
 #include <algorithm>
@@ -41,108 +42,163 @@ struct SpectralPeak
 };
 
 /**
- * Extract dominant spectral peaks from FFT output
+ * Extract dominant spectral peaks from FFT output into caller-owned storage
+ *
+ * Allocation-free version used on the audio/analysis path. Local maxima are found
+ * on squared magnitudes, so the square root is only taken at the three bins of
+ * each candidate peak. The strongest peaks are kept in a bounded min-heap.
  *
  * SOURCES:
- * - audiodev.blog: magnitude extraction pattern using std::abs()
+ * - audiodev.blog: magnitude extraction pattern (|X|^2 = re^2 + im^2)
  * - DSPRelated: quadratic interpolation for frequency accuracy
- * - JUCE forums: peak sorting and selection
+ * - JUCE FloatVectorOperations: SIMD squaring and chunk maximum
+ * - std::push_heap / pop_heap: bounded top-K selection
  *
  * @param fftData Complex FFT output (interleaved real/imag format from JUCE FFT)
  * @param numBins Number of frequency bins (fftSize / 2 + 1 for real FFT)
  * @param maxPeaks Maximum number of peaks to extract (e.g., 33 for Panharmonium)
  * @param sampleRate Sample rate in Hz
  * @param fftSize FFT window size
- * @return Vector of spectral peaks sorted by magnitude (strongest first)
+ * @param powerScratch Caller buffer of at least 2 * numBins floats (overwritten)
+ * @param peaksOut Caller buffer of at least maxPeaks entries
+ * @param firstBin Lowest bin that may hold a peak (band-limited analysis; >= 1)
+ * @return Number of peaks written, sorted by magnitude (strongest first)
  */
-inline std::vector<SpectralPeak> extractDominantPeaks(
+inline int extractDominantPeaks(
     const float* fftData,
     int numBins,
     int maxPeaks,
     double sampleRate,
-    int fftSize)
+    int fftSize,
+    float* powerScratch,
+    SpectralPeak* peaksOut,
+    int firstBin = 1)
 {
-    // SOURCE: audiodev.blog - reinterpret JUCE FFT output as complex numbers
-    auto* complexData = reinterpret_cast<const std::complex<float>*>(fftData);
+    if (numBins < 3 || maxPeaks <= 0)
+        return 0;
 
-    // Extract magnitude for all bins
-    // SOURCE: audiodev.blog - magnitude extraction and normalization pattern
-    std::vector<float> magnitudes;
-    magnitudes.reserve(numBins);
+    // Squared magnitude per bin: square every re/im value (SIMD), then sum pairs in place.
+    // Writes to bin i never overtake the reads at 2i and 2i + 1.
+    juce::FloatVectorOperations::multiply(powerScratch, fftData, fftData, numBins * 2);
 
     for (int i = 0; i < numBins; ++i)
-    {
-        // Extract magnitude and normalize by FFT size
-        // SOURCE: audiodev.blog FFT tutorial - std::abs() for complex magnitude
-        float mag = std::abs(complexData[i]) / static_cast<float>(fftSize);
-        magnitudes.push_back(mag);
-    }
+        powerScratch[i] = powerScratch[2 * i] + powerScratch[2 * i + 1];
+
+    // Normalise by FFT size only where a magnitude is actually needed
+    // SOURCE: audiodev.blog FFT tutorial - magnitude normalization
+    const float normalisation = 1.0f / static_cast<float>(fftSize);
+    auto* complexData = reinterpret_cast<const std::complex<float>*>(fftData);
+
+    // Min-heap on magnitude: peaksOut[0] is the weakest peak kept so far
+    auto strongerFirst = [](const SpectralPeak& a, const SpectralPeak& b) {
+        return a.magnitude > b.magnitude;
+    };
+
+    int numPeaks = 0;
+
+    // Once the heap is full, a bin can only enter if its interpolated magnitude beats
+    // the weakest kept peak. Interpolation raises a local maximum by at most 12.5%
+    // (|delta| <= 0.5, |y[-1] - y[+1]| < y[0]), so bins at or below this power are skipped.
+    float skipPower = -1.0f;
 
-    // Find local maxima (peaks)
-    // SOURCE: DSPRelated - peak detection by comparing with neighbors
-    std::vector<SpectralPeak> candidatePeaks;
-    candidatePeaks.reserve(numBins / 4);  // Estimate ~25% of bins could be peaks
+    constexpr int chunkSize = 16;
+    const int lastBin = numBins - 2;
 
-    for (int i = 1; i < numBins - 1; ++i)
+    for (int chunkStart = std::max(1, firstBin); chunkStart <= lastBin; chunkStart += chunkSize)
     {
-        // Local maximum if greater than both neighbors
-        if (magnitudes[i] > magnitudes[i - 1] && magnitudes[i] > magnitudes[i + 1])
+        const int chunkEnd = std::min(chunkStart + chunkSize, lastBin + 1);
+
+        // Vectorised rejection of whole chunks that cannot hold a new peak
+        if (skipPower >= 0.0f
+            && juce::FloatVectorOperations::findMaximum(powerScratch + chunkStart,
+                                                        chunkEnd - chunkStart) <= skipPower)
+            continue;
+
+        for (int i = chunkStart; i < chunkEnd; ++i)
         {
+            const float power = powerScratch[i];
+
+            // Local maximum if greater than both neighbors (same ordering as magnitude)
+            // SOURCE: DSPRelated - peak detection by comparing with neighbors
+            if (power <= skipPower || power <= powerScratch[i - 1] || power <= powerScratch[i + 1])
+                continue;
+
             // Quadratic interpolation for sub-bin frequency accuracy
             // SOURCE: DSPRelated - parabolic peak interpolation formula
-            float y_minus1 = magnitudes[i - 1];
-            float y0 = magnitudes[i];
-            float y_plus1 = magnitudes[i + 1];
+            const float y_minus1 = std::sqrt(powerScratch[i - 1]) * normalisation;
+            const float y0 = std::sqrt(power) * normalisation;
+            const float y_plus1 = std::sqrt(powerScratch[i + 1]) * normalisation;
 
-            // Calculate interpolated position delta
-            // Formula: delta = (y[-1] - y[+1]) / (2(2*y[0] - y[+1] - y[-1]))
-            float denominator = 2.0f * (2.0f * y0 - y_plus1 - y_minus1);
+            // Formula: delta = (y[+1] - y[-1]) / (2(2*y[0] - y[+1] - y[-1])) (towards the larger neighbour)
+            const float denominator = 2.0f * (2.0f * y0 - y_plus1 - y_minus1);
             float delta = 0.0f;
 
             if (std::abs(denominator) > 1e-10f)
-            {
-                delta = (y_minus1 - y_plus1) / denominator;
-                // Clamp delta to reasonable range [-0.5, 0.5]
-                delta = juce::jlimit(-0.5f, 0.5f, delta);
-            }
-
-            // Calculate interpolated frequency
-            // SOURCE: audiodev.blog - bin to frequency conversion
-            float interpolatedBin = static_cast<float>(i) + delta;
-            float frequency = (interpolatedBin * static_cast<float>(sampleRate)) /
-                            static_cast<float>(fftSize);
+                delta = juce::jlimit(-0.5f, 0.5f, (y_plus1 - y_minus1) / denominator);
 
             // Interpolated magnitude using parabola vertex formula
             // SOURCE: DSPRelated - interpolated magnitude calculation
-            float interpolatedMag = y0 - 0.25f * (y_minus1 - y_plus1) * delta;
+            const float interpolatedMag = y0 - 0.25f * (y_minus1 - y_plus1) * delta;
 
-            // Extract phase at peak bin
-            // SOURCE: audiodev.blog - phase extraction from complex FFT
-            float phase = std::arg(complexData[i]);
+            if (numPeaks == maxPeaks && interpolatedMag <= peaksOut[0].magnitude)
+                continue;
 
-            candidatePeaks.emplace_back(frequency, interpolatedMag, phase, i);
-        }
-    }
+            // SOURCE: audiodev.blog - bin to frequency conversion, phase at peak bin
+            const float frequency = ((static_cast<float>(i) + delta) * static_cast<float>(sampleRate))
+                                  / static_cast<float>(fftSize);
+            const SpectralPeak peak(frequency, interpolatedMag, std::arg(complexData[i]), i);
 
-    // Sort peaks by magnitude (descending)
-    // SOURCE: JUCE forums - peak selection by sorting
-    std::sort(candidatePeaks.begin(), candidatePeaks.end(),
-              [](const SpectralPeak& a, const SpectralPeak& b) {
-                  return a.magnitude > b.magnitude;
-              });
+            if (numPeaks < maxPeaks)
+            {
+                peaksOut[numPeaks++] = peak;
+                std::push_heap(peaksOut, peaksOut + numPeaks, strongerFirst);
+            }
+            else
+            {
+                std::pop_heap(peaksOut, peaksOut + numPeaks, strongerFirst);
+                peaksOut[numPeaks - 1] = peak;
+                std::push_heap(peaksOut, peaksOut + numPeaks, strongerFirst);
+            }
 
-    // Extract top N peaks
-    // SOURCE: JUCE forums - limiting peak count pattern
-    int numPeaksToExtract = std::min(maxPeaks, static_cast<int>(candidatePeaks.size()));
+            if (numPeaks == maxPeaks)
+            {
+                const float bound = peaksOut[0].magnitude / (1.125f * normalisation);
+                skipPower = bound * bound;
+            }
+        }
+    }
 
-    std::vector<SpectralPeak> dominantPeaks;
-    dominantPeaks.reserve(numPeaksToExtract);
+    // Heap order -> strongest first
+    std::sort_heap(peaksOut, peaksOut + numPeaks, strongerFirst);
+    return numPeaks;
+}
 
-    for (int i = 0; i < numPeaksToExtract; ++i)
-    {
-        dominantPeaks.push_back(candidatePeaks[i]);
-    }
+/**
+ * Extract dominant spectral peaks from FFT output
+ *
+ * Convenience wrapper that allocates its own storage - use the overload above on
+ * the audio thread.
+ *
+ * @param fftData Complex FFT output (interleaved real/imag format from JUCE FFT)
+ * @param numBins Number of frequency bins (fftSize / 2 + 1 for real FFT)
+ * @param maxPeaks Maximum number of peaks to extract (e.g., 33 for Panharmonium)
+ * @param sampleRate Sample rate in Hz
+ * @param fftSize FFT window size
+ * @return Vector of spectral peaks sorted by magnitude (strongest first)
+ */
+inline std::vector<SpectralPeak> extractDominantPeaks(
+    const float* fftData,
+    int numBins,
+    int maxPeaks,
+    double sampleRate,
+    int fftSize)
+{
+    std::vector<float> powerScratch(static_cast<size_t>(std::max(numBins, 0)) * 2);
+    std::vector<SpectralPeak> dominantPeaks(static_cast<size_t>(std::max(maxPeaks, 0)));
 
+    const int numPeaks = extractDominantPeaks(fftData, numBins, maxPeaks, sampleRate, fftSize,
+                                              powerScratch.data(), dominantPeaks.data());
+    dominantPeaks.resize(static_cast<size_t>(numPeaks));
     return dominantPeaks;
 }
 
@@ -153,10 +209,12 @@ inline std::vector<SpectralPeak> extractDominantPeaks(
  *   - YES: audiodev.blog FFT tutorial (magnitude extraction, complex handling)
  *   - YES: DSPRelated (quadratic interpolation pattern)
  *   - YES: JUCE forums (peak sorting and selection)
+ *   - YES: JUCE FloatVectorOperations (SIMD squaring, chunk maximum)
  *
  * ✓ Rule #2: 95%+ certain?
  *   - YES: Exact patterns from verified sources
  *   - YES: Standard DSP peak detection with quadratic interpolation
+ *   - YES: Heap selection returns the same top-N as a full sort (ties aside)
  *
  * ✓ Rule #3: Verified against real JUCE code?
  *   - YES: audiodev.blog is trusted JUCE FFT source
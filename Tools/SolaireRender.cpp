@@ -0,0 +1,327 @@
+/**
+ * Solaire Offline Renderer
+ *
+ * Console app that bounces audio files through Solaire without a DAW.
+ *
+ * Run: solaire_render --preset=<state> [--block=512] [--jobs=<threads>]
+ *                     [--output-dir=<dir>] [--suffix=_solaire] [--bits=32]
+ *                     <input files...>
+ *
+ * - The preset is the plugin state: the APVTS XML written by getStateInformation()
+ *   (plain XML, or the binary chunk a host stores)
+ * - Each file is rendered by its own SolaireAudioProcessor, driven exactly as a
+ *   host's offline bounce drives the plugin (non-realtime, fixed block size), so
+ *   output is bit-identical to the plugin for the same block size - it doubles
+ *   as a regression harness
+ * - Audio is streamed block by block from reader to writer; whole files are
+ *   never loaded
+ * - Latency is flushed: the input is followed by getLatencySamples() of silence
+ *   and the first getLatencySamples() of output are dropped, so the output is
+ *   sample-aligned with the input and has the same length
+ * - Files render in parallel on a thread pool; when there are fewer files than
+ *   cores, each processor also runs its channels on its worker pool
+ *
+ * SOURCES:
+ * - JUCE CMake ConsoleApp example: juce_add_console_app target layout
+ * - juce::AudioFormatReader / AudioFormatWriter streaming (JUCE AudioFormat docs)
+ * - juce::ThreadPool (JUCE ThreadPool docs)
+ */
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "PluginProcessor.h"
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    //==============================================================================
+    struct RenderOptions
+    {
+        juce::MemoryBlock state;          // Plugin state passed to setStateInformation()
+        juce::File outputDirectory;       // Default: next to each input file
+        juce::String suffix = "_solaire";
+        int blockSize = 512;
+        int bitsPerSample = 32;           // 32 = float WAV (exact plugin output)
+        bool parallelChannels = false;
+    };
+
+    struct RenderResult
+    {
+        juce::File input;
+        juce::File output;
+        juce::String error;               // Empty on success
+        juce::int64 numSamples = 0;
+        double seconds = 0.0;
+        double sampleRate = 0.0;
+    };
+
+    //==============================================================================
+    // Read the preset as XML, or as the binary state chunk a host would store
+    bool loadPreset(const juce::File& file, juce::MemoryBlock& state)
+    {
+        if (!file.existsAsFile())
+            return false;
+
+        if (auto xml = juce::XmlDocument::parse(file))
+        {
+            juce::AudioProcessor::copyXmlToBinary(*xml, state);
+            return true;
+        }
+
+        return file.loadFileAsData(state) && state.getSize() > 0;
+    }
+
+    // Apply the preset and check the processor actually accepted it
+    // (setStateInformation() silently ignores a state with the wrong root tag)
+    bool applyState(SolaireAudioProcessor& processor, const juce::MemoryBlock& state)
+    {
+        const auto preset = juce::AudioProcessor::getXmlFromBinary(state.getData(), static_cast<int>(state.getSize()));
+
+        if (preset == nullptr)
+            return false;
+
+        processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+
+        juce::MemoryBlock applied;
+        processor.getStateInformation(applied);
+        const auto current = juce::AudioProcessor::getXmlFromBinary(applied.getData(), static_cast<int>(applied.getSize()));
+
+        return current != nullptr && current->getTagName() == preset->getTagName();
+    }
+
+    juce::File getOutputFile(const juce::File& input, const RenderOptions& options)
+    {
+        const auto directory = (options.outputDirectory == juce::File()) ? input.getParentDirectory()
+                                                                          : options.outputDirectory;
+        return directory.getChildFile(input.getFileNameWithoutExtension() + options.suffix + ".wav");
+    }
+
+    //==============================================================================
+    RenderResult renderFile(const juce::File& input, const RenderOptions& options)
+    {
+        RenderResult result;
+        result.input = input;
+        result.output = getOutputFile(input, options);
+
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(input));
+
+        if (reader == nullptr)
+        {
+            result.error = "unreadable audio file";
+            return result;
+        }
+
+        const int numChannels = static_cast<int>(reader->numChannels);
+        const double sampleRate = reader->sampleRate;
+        const juce::int64 length = reader->lengthInSamples;
+        const int blockSize = options.blockSize;
+
+        // Configure the processor as a host would for an offline bounce
+        auto processor = std::make_unique<SolaireAudioProcessor>();
+
+        const auto channelSet = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add(channelSet);
+        layout.outputBuses.add(channelSet);
+
+        if (!processor->setBusesLayout(layout))
+        {
+            result.error = "unsupported channel count (" + juce::String(numChannels) + ")";
+            return result;
+        }
+
+        if (!applyState(*processor, options.state))
+        {
+            result.error = "preset is not a Solaire state";
+            return result;
+        }
+
+        if (options.parallelChannels)
+            processor->setParallelChannelThreshold(1);
+
+        processor->setNonRealtime(true);
+        processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+
+        const auto latency = static_cast<juce::int64>(processor->getLatencySamples());
+
+        // Replace any previous render, then stream blocks from reader to writer
+        result.output.deleteFile();
+        std::unique_ptr<juce::OutputStream> stream(result.output.createOutputStream());
+
+        juce::WavAudioFormat wavFormat;
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+
+        if (stream != nullptr)
+        {
+            writer.reset(wavFormat.createWriterFor(stream.get(), sampleRate,
+                                                   static_cast<unsigned int>(numChannels),
+                                                   options.bitsPerSample, {}, 0));
+        }
+
+        if (writer == nullptr)
+        {
+            result.error = "cannot write " + result.output.getFullPathName();
+            return result;
+        }
+
+        stream.release();  // Owned by the writer from here on
+
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        juce::MidiBuffer midi;
+
+        // Full blocks only (the last one zero-padded), as in a fixed-size bounce;
+        // output sample n + latency lines up with input sample n
+        for (juce::int64 position = 0; position < length + latency; position += blockSize)
+        {
+            // read() zero-fills past the end of the file, which is also the latency flush
+            reader->read(&buffer, 0, blockSize, position, true, true);
+            processor->processBlock(buffer, midi);
+
+            const juce::int64 firstKept = juce::jmax(position, latency);
+            const juce::int64 endKept = juce::jmin(position + blockSize, length + latency);
+
+            if (endKept > firstKept)
+            {
+                writer->writeFromAudioSampleBuffer(buffer, static_cast<int>(firstKept - position),
+                                                   static_cast<int>(endKept - firstKept));
+            }
+        }
+
+        processor->releaseResources();
+        writer.reset();  // Finalises the WAV header
+
+        result.numSamples = length;
+        result.sampleRate = sampleRate;
+        result.seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        return result;
+    }
+
+    //==============================================================================
+    void printUsage()
+    {
+        std::cout << "Usage: solaire_render --preset=<state.xml> [--block=512] [--jobs=<threads>]\n"
+                     "                      [--output-dir=<dir>] [--suffix=_solaire] [--bits=16|24|32]\n"
+                     "                      <input files...>\n";
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    // Message manager for the APVTS internals (parameter timers, value trees)
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    const juce::ArgumentList args(argc, argv);
+
+    RenderOptions options;
+    juce::Array<juce::File> inputs;
+
+    for (const auto& argument : args.arguments)
+        if (!argument.isOption())
+            inputs.add(argument.resolveAsFile());
+
+    const auto presetFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--preset"));
+
+    if (inputs.isEmpty() || !args.containsOption("--preset"))
+    {
+        printUsage();
+        return 1;
+    }
+
+    if (!loadPreset(presetFile, options.state))
+    {
+        std::cerr << "Cannot read preset " << presetFile.getFullPathName().toRawUTF8() << "\n";
+        return 1;
+    }
+
+    if (args.containsOption("--block"))
+        options.blockSize = juce::jlimit(16, 8192, args.getValueForOption("--block").getIntValue());
+
+    if (args.containsOption("--bits"))
+        options.bitsPerSample = args.getValueForOption("--bits").getIntValue();
+
+    if (options.bitsPerSample != 16 && options.bitsPerSample != 24 && options.bitsPerSample != 32)
+    {
+        std::cerr << "--bits must be 16, 24 or 32\n";
+        return 1;
+    }
+
+    if (args.containsOption("--suffix"))
+        options.suffix = args.getValueForOption("--suffix");
+
+    if (args.containsOption("--output-dir"))
+    {
+        options.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--output-dir"));
+
+        if (!options.outputDirectory.createDirectory())
+        {
+            std::cerr << "Cannot create " << options.outputDirectory.getFullPathName().toRawUTF8() << "\n";
+            return 1;
+        }
+    }
+
+    // One job per file; spare cores go to the channels of each file
+    const int numCpus = juce::SystemStats::getNumCpus();
+    const int numJobs = args.containsOption("--jobs") ? juce::jmax(1, args.getValueForOption("--jobs").getIntValue())
+                                                       : numCpus;
+    const int numThreads = juce::jmin(numJobs, inputs.size());
+    options.parallelChannels = (numThreads < numCpus);
+
+    std::vector<RenderResult> results(static_cast<size_t>(inputs.size()));
+    std::atomic<int> numFinished{0};
+    const auto start = juce::Time::getHighResolutionTicks();
+
+    {
+        juce::ThreadPool pool(numThreads);
+
+        for (int i = 0; i < inputs.size(); ++i)
+        {
+            pool.addJob([&, i]
+            {
+                results[static_cast<size_t>(i)] = renderFile(inputs[i], options);
+                ++numFinished;
+            });
+        }
+
+        while (numFinished.load() < inputs.size())
+            juce::Thread::sleep(20);
+    }
+
+    const double wallSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+    int numFailed = 0;
+    double totalAudioSeconds = 0.0;
+
+    for (const auto& result : results)
+    {
+        if (result.error.isNotEmpty())
+        {
+            ++numFailed;
+            std::cerr << "FAILED " << result.input.getFullPathName().toRawUTF8()
+                      << ": " << result.error.toRawUTF8() << "\n";
+            continue;
+        }
+
+        const double audioSeconds = static_cast<double>(result.numSamples) / result.sampleRate;
+        totalAudioSeconds += audioSeconds;
+
+        std::cout << result.output.getFullPathName().toRawUTF8() << " ("
+                  << juce::String(audioSeconds / juce::jmax(1.0e-9, result.seconds), 1).toRawUTF8()
+                  << "x realtime)\n";
+    }
+
+    std::cout << (results.size() - static_cast<size_t>(numFailed)) << " rendered, " << numFailed << " failed; "
+              << juce::String(totalAudioSeconds, 1).toRawUTF8() << " s of audio in "
+              << juce::String(wallSeconds, 1).toRawUTF8() << " s on " << numThreads << " threads\n";
+
+    return numFailed == 0 ? 0 : 1;
+}